@@ -0,0 +1,111 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cppargparse/cppargparse.h>
+
+
+// Return the best time of <iterations> calls to <run> in milliseconds
+template <typename Run>
+double best_of(const int iterations, Run run)
+{
+    double best = 0.0;
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double milliseconds = std::chrono::duration<double, std::milli>(stop - start).count();
+
+        if (i == 0 || milliseconds < best)
+        {
+            best = milliseconds;
+        }
+    }
+
+    return best;
+}
+
+
+int main(int argc, char *argv[])
+{
+    using namespace cppargparse;
+
+    const size_t parser_count = (argc > 1) ? std::stoul(argv[1]) : 1000;
+    const int iterations = (argc > 2) ? std::stoi(argv[2]) : 20;
+
+    // Flags and options registered per parser, all of them passed
+    std::vector<std::string> ids;
+    std::vector<char *> cmd {const_cast<char *>("benchmark")};
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        ids.push_back("--flag-" + std::to_string(i));
+    }
+
+    for (auto &id : ids)
+    {
+        cmd.push_back(&id[0]);
+    }
+
+    cmd.push_back(const_cast<char *>("-n"));
+    cmd.push_back(const_cast<char *>("42"));
+
+    size_t calls = 0;
+    long sum = 0;
+    long offset = 1;
+    long factor = 2;
+
+    // Captures three pointers: too large for std::function's small buffer
+    const auto on_flag = [&calls, &offset, &factor](const parser::ArgumentParser &)
+    {
+        calls += static_cast<size_t>(offset * factor);
+    };
+
+    const auto on_value = [&sum, &offset, &factor](const parser::ArgumentParser &, const int &value)
+    {
+        sum += value * factor + offset;
+    };
+
+    const double wrapped = best_of(iterations, [&]()
+    {
+        for (size_t p = 0; p < parser_count; ++p)
+        {
+            parser::ArgumentParser arg_parser(static_cast<int>(cmd.size()), cmd.data(), "benchmark -- callbacks");
+
+            for (const auto &id : ids)
+            {
+                arg_parser.add_flag_with_callback(id, std::function<void(const parser::ArgumentParser &)>(on_flag));
+            }
+
+            arg_parser.add_arg_with_callback<int>("-n",
+                    std::function<void(const parser::ArgumentParser &, const int &)>(on_value));
+        }
+    });
+
+    const double templated = best_of(iterations, [&]()
+    {
+        for (size_t p = 0; p < parser_count; ++p)
+        {
+            parser::ArgumentParser arg_parser(static_cast<int>(cmd.size()), cmd.data(), "benchmark -- callbacks");
+
+            for (const auto &id : ids)
+            {
+                arg_parser.add_flag_with_callback(id, on_flag);
+            }
+
+            arg_parser.add_arg_with_callback<int>("-n", on_value);
+        }
+    });
+
+    std::cout << "parsers x callbacks:        " << parser_count << " x " << ids.size() + 1 << '\n'
+              << "std::function [ms]:         " << wrapped << '\n'
+              << "templated callable [ms]:    " << templated << '\n'
+              << "(calls: " << calls << ", sum: " << sum << ")" << '\n';
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cppargparse/cppargparse.h>
+
+
+// Generate a NUL-separated command line like found in /proc/<pid>/cmdline
+std::string make_cmdline(const size_t i)
+{
+    std::string cmdline;
+
+    const auto append = [&cmdline](const std::string &token)
+    {
+        cmdline.append(token);
+        cmdline.push_back('\0');
+    };
+
+    append("/usr/bin/java");
+    append("-Xmx");
+    append(std::to_string(1024 + i % 4096));
+    append("--port");
+    append(std::to_string(8000 + i % 1000));
+    append("--config");
+    append("/etc/service/worker_" + std::to_string(i) + ".conf");
+
+    if (i % 3 == 0)
+    {
+        append("--debug");
+    }
+
+    append("--hosts");
+
+    for (size_t host = 0; host < 4; ++host)
+    {
+        append("node" + std::to_string(host) + ".cluster.local");
+    }
+
+    append("app.jar");
+    return cmdline;
+}
+
+
+// Parse all buffers <iterations> times and return the processes per second
+double run(const cppargparse::schema::Schema &schema,
+           const std::vector<cppargparse::cmd::TokenView> &buffers,
+           std::vector<cppargparse::schema::Result> &results,
+           const unsigned int thread_count,
+           const int iterations)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        cppargparse::schema::parse_batch(schema, buffers, results, thread_count);
+    }
+
+    const auto stop = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+
+    return static_cast<double>(buffers.size()) * iterations / seconds;
+}
+
+
+int main(int argc, char *argv[])
+{
+    using namespace cppargparse;
+
+    const size_t process_count = (argc > 1) ? std::stoul(argv[1]) : 20000;
+    const int iterations = (argc > 2) ? std::stoi(argv[2]) : 20;
+
+    schema::Schema schema;
+    schema.add("-Xmx");
+    schema.add("-p", "--port");
+    schema.add("-c", "--config");
+    schema.add("-d", "--debug");
+    schema.add("--hosts");
+
+    for (int i = 0; i < 100; ++i)
+    {
+        schema.add("--option-" + std::to_string(i));
+    }
+
+    std::vector<std::string> cmdlines;
+    cmdlines.reserve(process_count);
+
+    for (size_t i = 0; i < process_count; ++i)
+    {
+        cmdlines.emplace_back(make_cmdline(i));
+    }
+
+    const std::vector<cmd::TokenView> buffers(cmdlines.cbegin(), cmdlines.cend());
+    std::vector<schema::Result> results;
+
+    const unsigned int hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Warm up the results
+    schema::parse_batch(schema, buffers, results, 1);
+
+    std::cout << "processes:                 " << process_count << '\n'
+              << "processes per second (1):  " << run(schema, buffers, results, 1, iterations) << '\n'
+              << "processes per second (" << hardware_threads << "): "
+              << run(schema, buffers, results, hardware_threads, iterations) << '\n';
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <cppargparse/cppargparse.h>
+
+
+// Write a response file with <token_count> tokens, every tenth of them quoted
+void write_response_file(const std::string &path, const size_t token_count)
+{
+    std::ofstream file(path, std::ios::binary);
+
+    for (size_t i = 0; i < token_count; ++i)
+    {
+        if (i % 10 == 0)
+        {
+            file << "'/data/input dir/file_" << i << ".bin'\n";
+        }
+        else
+        {
+            file << "/data/input/file_" << i << ".bin\n";
+        }
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    using namespace cppargparse;
+
+    const size_t token_count = (argc > 1) ? std::stoul(argv[1]) : 1000000;
+    const int iterations = (argc > 2) ? std::stoi(argv[2]) : 5;
+    const std::string path = "benchmark_response_file.rsp";
+
+    write_response_file(path, token_count);
+
+    std::string token = "@" + path;
+    char *cmd[] = {const_cast<char *>("--files"), &token[0]};
+
+    double best = 0.0;
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        parser::ArgumentParser arg_parser(2, cmd, "benchmark -- response file");
+        const auto files = arg_parser.add_arg("--files");
+
+        const auto stop = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(stop - start).count();
+
+        if (i == 0 || seconds < best)
+        {
+            best = seconds;
+        }
+
+        if (!arg_parser.get_flag(files))
+        {
+            return 1;
+        }
+    }
+
+    std::remove(path.c_str());
+
+    std::cout << "tokens:            " << token_count << '\n'
+              << "best of " << iterations << " [ms]:    " << best * 1000.0 << '\n'
+              << "tokens per second: " << static_cast<double>(token_count) / best << '\n';
+
+    return 0;
+}
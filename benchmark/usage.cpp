@@ -0,0 +1,122 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <cppargparse/cppargparse.h>
+
+
+// The previous renderer: std::ostringstream, padding one space at a time
+std::string render_ostringstream(const std::string &description, const cppargparse::cmd::CommandLineArguments_t &cmdargs)
+{
+    size_t max_id_length = 0;
+
+    for (const auto &cmdarg : cmdargs)
+    {
+        const size_t id_length = cmdarg.id().size() + cmdarg.id_alt().size();
+
+        if (id_length > max_id_length)
+        {
+            max_id_length = id_length;
+        }
+    }
+
+    max_id_length += 3;
+
+    std::ostringstream usage_string;
+    usage_string << "Usage: " << description << '\n' << '\n';
+
+    for (const auto &cmdarg : cmdargs)
+    {
+        usage_string << ' ' << ' ' << cmdarg.id();
+
+        if (!cmdarg.id_alt().empty())
+        {
+            usage_string << '|' << cmdarg.id_alt();
+        }
+
+        for (size_t i = 0; i < max_id_length; ++i)
+        {
+            usage_string << ' ';
+        }
+
+        usage_string << cmdarg.description() << '\n';
+    }
+
+    return usage_string.str();
+}
+
+
+// Return the best time of <iterations> calls to <render> in milliseconds
+template <typename Render>
+double best_of(const int iterations, Render render, size_t &size)
+{
+    double best = 0.0;
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        size = render().size();
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double milliseconds = std::chrono::duration<double, std::milli>(stop - start).count();
+
+        if (i == 0 || milliseconds < best)
+        {
+            best = milliseconds;
+        }
+    }
+
+    return best;
+}
+
+
+int main(int argc, char *argv[])
+{
+    using namespace cppargparse;
+
+    const size_t option_count = (argc > 1) ? std::stoul(argv[1]) : 10000;
+    const int iterations = (argc > 2) ? std::stoi(argv[2]) : 20;
+
+    char *cmd[] = {const_cast<char *>("benchmark")};
+    parser::ArgumentParser arg_parser(1, cmd, "benchmark -- usage");
+
+    for (size_t i = 0; i < option_count; ++i)
+    {
+        const std::string name = std::to_string(i);
+        arg_parser.add_arg("-o" + name, "--option-" + name,
+                "Option number " + name + " of the benchmark, with a description long enough to be wrapped "
+                "at least once on an 80 column terminal");
+    }
+
+    size_t size = 0;
+
+    const double ostringstream = best_of(iterations, [&]()
+    {
+        return render_ostringstream("benchmark -- usage", arg_parser.args());
+    }, size);
+
+    const double render = best_of(iterations, [&]()
+    {
+        return usage::render("benchmark -- usage", arg_parser.args(), 0);
+    }, size);
+
+    const double render_wrapped = best_of(iterations, [&]()
+    {
+        return usage::render("benchmark -- usage", arg_parser.args(), 80);
+    }, size);
+
+    const double cached = best_of(iterations, [&]() -> const std::string &
+    {
+        return arg_parser.usage(80);
+    }, size);
+
+    std::cout << "options:                    " << option_count << '\n'
+              << "usage size [bytes]:         " << size << '\n'
+              << "ostringstream [ms]:         " << ostringstream << '\n'
+              << "render [ms]:                " << render << '\n'
+              << "render, 80 columns [ms]:    " << render_wrapped << '\n'
+              << "usage(), cached [ms]:       " << cached << '\n';
+
+    return 0;
+}
@@ -8,6 +8,9 @@
 
 
 #include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "cmd.h"
 
@@ -60,6 +63,72 @@ cmd::CommandLinePosition_t find_arg_position(const cmd::CommandLine_t &cmd, cons
 }
 
 
+/**
+ * @brief Return whether a token looks like an option.
+ *
+ * Options start with '-' and have at least one more character. Negative numbers such as "-5" or "-.5"
+ * are values, not options.
+ *
+ * @param token The command line token.
+ *
+ * @return Whether @p token looks like an option.
+ */
+inline bool is_option_like(const cmd::TokenView &token)
+{
+    if (token.size() < 2 || token[0] != '-')
+    {
+        return false;
+    }
+
+    const char c = token[1];
+
+    if (c >= '0' && c <= '9')
+    {
+        return false;
+    }
+
+    return !(c == '.' && token.size() > 2 && token[2] >= '0' && token[2] <= '9');
+}
+
+
+/**
+ * @brief Return whether a token starts with a short ID but is longer, e.g. "-vx" or "-t5".
+ *
+ * Such tokens bundle short options ("-vx" for "-v -x") or attach a value to one ("-t5" for "-t 5").
+ *
+ * @tparam IsKnown bool(const cmd::TokenView &id)
+ *
+ * @param token The command line token.
+ * @param is_known Whether an ID belongs to a known argument.
+ *
+ * @return Whether @p token starts with the short ID of a known argument and has more characters.
+ */
+template <typename IsKnown>
+inline bool is_short_bundle(const cmd::TokenView &token, IsKnown is_known)
+{
+    return token.size() > 2 && token[1] != '-' && is_option_like(token) && is_known(cmd::TokenView(token.data(), 2));
+}
+
+
+/**
+ * @brief Return whether a command line token starts a known argument: it is one of the IDs or starts with a short one.
+ *
+ * @param cmdargs The command line arguments.
+ * @param token The command line token.
+ *
+ * @return Whether @p token belongs to one of @p cmdargs.
+ */
+inline bool is_arg_token(const cmd::CommandLineArguments_t &cmdargs, const std::string &token)
+{
+    const auto is_known = [&cmdargs](const cmd::TokenView &id)
+    {
+        return find_arg(cmdargs, id.str()) != cmdargs.cend();
+    };
+
+    return find_arg(cmdargs, token) != cmdargs.cend() || is_short_bundle(cmd::TokenView(token), is_known);
+}
+
+
 /**
  * @brief Return command line positions of an argument vector option.
  *
@@ -78,7 +147,7 @@ cmd::CommandLinePositions_t get_option_positions(
 
     for (auto current = std::next(position); current != cmd.end(); ++current)
     {
-        if (find_arg(cmdargs, *current) != cmdargs.cend())
+        if (is_arg_token(cmdargs, *current))
         {
             break;
         }
@@ -90,6 +159,155 @@ cmd::CommandLinePositions_t get_option_positions(
 }
 
 
+template <typename IsKnown>
+/**
+ * @brief Find an argument's command line position by its ID, also inside bundled short options and attached values.
+ *
+ * Tokens equal to an ID come first. Otherwise the short ID is looked for in tokens like "-vxf" or "-t5": scanning
+ * from the second character, every character before the argument's one must be the short ID of a known argument.
+ * The characters after it are either more bundled options or the argument's attached value, which only the caller
+ * can tell apart. Tokens starting with the short ID, e.g. "-t5", take precedence over ones bundling it further on,
+ * e.g. "-vt": in "-ofile", "-i" might as well be part of the value. Tokens after "--" are skipped.
+ *
+ * @tparam IsKnown bool(const cmd::TokenView &id)
+ *
+ * @param cmd The command line.
+ * @param id The argument ID.
+ * @param id_alt The argument alternative ID.
+ * @param is_known Whether an ID belongs to a known argument.
+ * @param offset Receives the offset of the rest of the token after the argument's ID, the token size for whole tokens.
+ *
+ * @return The command line iterator position of the token holding the argument.
+ */
+inline cmd::CommandLinePosition_t find_arg_position(
+        const cmd::CommandLine_t &cmd, const std::string &id, const std::string &id_alt, IsKnown is_known, size_t &offset)
+{
+    auto it = find_arg_position(cmd, id, id_alt);
+
+    if (it != cmd.cend())
+    {
+        offset = it->size();
+        return it;
+    }
+
+    auto bundled = cmd.cend();
+
+    for (it = cmd.cbegin(); it != cmd.cend() && *it != "--"; ++it)
+    {
+        const cmd::TokenView token(*it);
+
+        if (!is_short_bundle(token, is_known))
+        {
+            continue;
+        }
+
+        for (size_t i = 1; i < token.size(); ++i)
+        {
+            const char short_id[] = {'-', token[i]};
+            const cmd::TokenView candidate(short_id, 2);
+
+            if (candidate == cmd::TokenView(id) || candidate == cmd::TokenView(id_alt))
+            {
+                if (i == 1)
+                {
+                    offset = i + 1;
+                    return it;
+                }
+
+                if (bundled == cmd.cend())
+                {
+                    bundled = it;
+                    offset = i + 1;
+                }
+
+                break;
+            }
+
+            if (!is_known(candidate))
+            {
+                break;
+            }
+        }
+    }
+
+    return bundled;
+}
+
+
+/**
+ * @brief Split "--name=value" tokens into "--name" and "value".
+ *
+ * The split offsets are recorded in one pass over the tokens, then the command line is rebuilt once.
+ * Tokens after "--" are kept as they are.
+ *
+ * @param cmd The command line.
+ *
+ * @return The command line with "=" attached values split off.
+ */
+inline cmd::CommandLine_t split_long_values(cmd::CommandLine_t cmd)
+{
+    std::vector<size_t> offsets(cmd.size(), std::string::npos);
+    size_t splits = 0;
+
+    for (size_t i = 0; i < cmd.size() && cmd[i] != "--"; ++i)
+    {
+        const std::string &token = cmd[i];
+
+        if (token.size() > 3 && token[0] == '-' && token[1] == '-')
+        {
+            offsets[i] = token.find('=', 3);
+            splits += (offsets[i] != std::string::npos) ? 1 : 0;
+        }
+    }
+
+    if (splits == 0)
+    {
+        return cmd;
+    }
+
+    cmd::CommandLine_t split;
+    split.reserve(cmd.size() + splits);
+
+    for (size_t i = 0; i < cmd.size(); ++i)
+    {
+        if (offsets[i] == std::string::npos)
+        {
+            split.push_back(std::move(cmd[i]));
+        }
+        else
+        {
+            split.emplace_back(cmd[i], 0, offsets[i]);
+            split.emplace_back(cmd[i], offsets[i] + 1);
+        }
+    }
+
+    return split;
+}
+
+
+/**
+ * @brief Return whether a fallback source entry enables a flag.
+ *
+ * Entries are small command lines of the form (name, value, ...).
+ * An entry without a value, "true", "yes", "on" and "1" enable a flag.
+ *
+ * @param entry The entry command line.
+ *
+ * @return Whether the entry enables a flag.
+ */
+inline bool is_enabled(const cmd::CommandLine_t &entry)
+{
+    if (entry.size() < 2)
+    {
+        return true;
+    }
+
+    const std::string &value = entry[1];
+
+    return value == "true" || value == "yes" || value == "on" || value == "1";
+}
+
+
 } // namespace algorithm
 } // namespace cppargparse
 
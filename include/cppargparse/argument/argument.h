@@ -1,6 +1,8 @@
 #ifndef CPPARGPARSE_ARGUMENT_ARGUMENT_H
 #define CPPARGPARSE_ARGUMENT_ARGUMENT_H
 
+#include <string>
+
 #include <cppargparse/cmd.h>
 
 
@@ -55,6 +57,31 @@ struct argument
 };
 
 
+template <typename T>
+/**
+ * @brief Return the type name reported by conversion errors, like the argument<T> converters do.
+ *
+ * @return The type name, a string literal.
+ */
+inline const char *type_name()
+{
+    return "value";
+}
+
+template <> inline const char *type_name<char>() { return "char"; }
+template <> inline const char *type_name<unsigned char>() { return "unsigned char"; }
+template <> inline const char *type_name<int>() { return "int"; }
+template <> inline const char *type_name<unsigned int>() { return "unsigned int"; }
+template <> inline const char *type_name<long>() { return "long"; }
+template <> inline const char *type_name<unsigned long>() { return "unsigned long"; }
+template <> inline const char *type_name<long long>() { return "long long"; }
+template <> inline const char *type_name<unsigned long long>() { return "unsigned long long"; }
+template <> inline const char *type_name<float>() { return "float"; }
+template <> inline const char *type_name<double>() { return "double"; }
+template <> inline const char *type_name<long double>() { return "long double"; }
+template <> inline const char *type_name<std::string>() { return "std::string"; }
+
+
 } // namespace cppargparse
 
 #endif // CPPARGPARSE_ARGUMENT_ARGUMENT_H
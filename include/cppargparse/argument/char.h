@@ -5,6 +5,7 @@
 #include <string>
 
 #include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
 
 #include "argument.h"
 #include "numerical.h"
@@ -51,38 +52,42 @@ struct argument<char>
     {
         if (position == cmd.cend())
         {
-            throw errors::CommandLineOptionError(error_message(std::prev(position), "char"));
+            errors::raise<errors::CommandLineOptionError>(
+                    errors::Code::MissingValue, static_cast<size_t>(std::prev(position) - cmd.cbegin()), "char",
+                    std::prev(position)->data(), std::prev(position)->size());
         }
 
-        try
-        {
-            return (*position)[0];
-        }
+        char value;
 
-        catch (const std::invalid_argument &)
-        {
-            throw errors::CommandLineOptionError(error_message(position, "char"));
-        }
-        catch (const std::out_of_range &)
+        if (try_convert(position->data(), position->data() + position->size(), value) != errors::Code::None)
         {
-            throw errors::CommandLineOptionError(error_message(position, "char"));
+            errors::raise<errors::CommandLineOptionError>(
+                    errors::Code::InvalidValue, static_cast<size_t>(position - cmd.cbegin()), "char",
+                    position->data(), position->size());
         }
+
+        return value;
     }
 
 
     /**
-     * @brief Generate an error message for a value that's not a char.
+     * @brief Try to convert a character range to a char value without throwing.
      *
-     * @param position The command line argument iterator.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the character.
      *
-     * @return An error message for a value that's not a char.
+     * @return errors::Code::None or errors::Code::InvalidValue if the range isn't exactly one character.
      */
-    static const char *error_message(const cmd::CommandLinePosition_t &position, const char *data_type)
+    static errors::Code try_convert(const char *first, const char *last, char &value)
     {
-        std::ostringstream message;
-        message << "Couldn't convert " << *position << "to type <" << data_type << ">";
+        if (last - first != 1)
+        {
+            return errors::Code::InvalidValue;
+        }
 
-        return message.str().c_str();
+        value = *first;
+        return errors::Code::None;
     }
 };
 
@@ -141,38 +146,42 @@ struct argument<unsigned char>
     {
         if (position == cmd.cend())
         {
-            throw errors::CommandLineOptionError(error_message(std::prev(position), "unsigned char"));
+            errors::raise<errors::CommandLineOptionError>(
+                    errors::Code::MissingValue, static_cast<size_t>(std::prev(position) - cmd.cbegin()), "unsigned char",
+                    std::prev(position)->data(), std::prev(position)->size());
         }
 
-        try
-        {
-            return (*position)[0];
-        }
+        unsigned char value;
 
-        catch (const std::invalid_argument &)
-        {
-            throw errors::CommandLineOptionError(error_message(position, "unsigned char"));
-        }
-        catch (const std::out_of_range &)
+        if (try_convert(position->data(), position->data() + position->size(), value) != errors::Code::None)
         {
-            throw errors::CommandLineOptionError(error_message(position, "unsigned char"));
+            errors::raise<errors::CommandLineOptionError>(
+                    errors::Code::InvalidValue, static_cast<size_t>(position - cmd.cbegin()), "unsigned char",
+                    position->data(), position->size());
         }
+
+        return value;
     }
 
 
     /**
-     * @brief Generate an error message for a value that's not a char.
+     * @brief Try to convert a character range to an unsigned char value without throwing.
      *
-     * @param position The command line argument iterator.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the character.
      *
-     * @return An error message for a value that's not a char.
+     * @return errors::Code::None or errors::Code::InvalidValue if the range isn't exactly one character.
      */
-    static const char *error_message(const cmd::CommandLinePosition_t &position, const char *data_type)
+    static errors::Code try_convert(const char *first, const char *last, unsigned char &value)
     {
-        std::ostringstream message;
-        message << "Couldn't convert " << *position << "to type <" << data_type << ">";
+        if (last - first != 1)
+        {
+            return errors::Code::InvalidValue;
+        }
 
-        return message.str().c_str();
+        value = static_cast<unsigned char>(*first);
+        return errors::Code::None;
     }
 };
 
@@ -32,7 +32,7 @@ struct argument<double>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<double>::convert(cmd, std::next(position), &wrap, "double");
+        return numerical_argument<double>::convert(cmd, std::next(position), &try_convert, "double");
     }
 
     /**
@@ -48,19 +48,23 @@ struct argument<double>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<double>::convert(cmd, position, &wrap, "double");
+        return numerical_argument<double>::convert(cmd, position, &try_convert, "double");
     }
 
     /**
-     * @brief Wrap std::stod() for use without default parameters.
+     * @brief Try to convert a character range to a double value without throwing.
      *
-     * @param s The string to convert to a double.
+     * Follows the std::stod() semantics.
      *
-     * @return The double value of the string passed.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the double value on success.
+     *
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static double wrap(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, double &value)
     {
-        return std::stod(s);
+        return numerical_argument<double>::try_convert<double>(first, last, value);
     }
 };
 
@@ -84,7 +88,7 @@ struct argument<long double>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<long double>::convert(cmd, std::next(position), &wrap, "long double");
+        return numerical_argument<long double>::convert(cmd, std::next(position), &try_convert, "long double");
     }
 
 
@@ -101,20 +105,24 @@ struct argument<long double>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<long double>::convert(cmd, position, &wrap, "long double");
+        return numerical_argument<long double>::convert(cmd, position, &try_convert, "long double");
     }
 
 
     /**
-     * @brief Wrap std::stold() for use without default parameters.
+     * @brief Try to convert a character range to a long double value without throwing.
+     *
+     * Follows the std::stold() semantics.
      *
-     * @param s The string to convert to a long double.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the long double value on success.
      *
-     * @return The long double value of the string passed.
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static long double wrap(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, long double &value)
     {
-        return std::stold(s);
+        return numerical_argument<long double>::try_convert<long double>(first, last, value);
     }
 };
 
@@ -32,7 +32,7 @@ struct argument<float>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<float>::convert(cmd, std::next(position), &wrap, "float");
+        return numerical_argument<float>::convert(cmd, std::next(position), &try_convert, "float");
     }
 
 
@@ -49,20 +49,24 @@ struct argument<float>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<float>::convert(cmd, position, &wrap, "float");
+        return numerical_argument<float>::convert(cmd, position, &try_convert, "float");
     }
 
 
     /**
-     * @brief Wrap std::stof() for use without default parameters.
+     * @brief Try to convert a character range to a float value without throwing.
      *
-     * @param s The string to convert to a float.
+     * Follows the std::stof() semantics.
      *
-     * @return The float value of the string passed.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the float value on success.
+     *
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static float wrap(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, float &value)
     {
-        return std::stof(s);
+        return numerical_argument<float>::try_convert<float>(first, last, value);
     }
 };
 
@@ -33,7 +33,7 @@ struct argument<int>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<int>::convert(cmd, std::next(position), &wrap, "int");
+        return numerical_argument<int>::convert(cmd, std::next(position), &try_convert, "int");
     }
 
 
@@ -50,20 +50,24 @@ struct argument<int>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<int>::convert(cmd, position, &wrap, "int");
+        return numerical_argument<int>::convert(cmd, position, &try_convert, "int");
     }
 
 
     /**
-     * @brief Wrap std::stoi() for use without default parameters.
+     * @brief Try to convert a character range to an int value without throwing.
      *
-     * @param s The string to convert to an int.
+     * Follows the std::stoi() semantics.
      *
-     * @return The int value of the string passed.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the int value on success.
+     *
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static int wrap(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, int &value)
     {
-        return std::stoi(s);
+        return numerical_argument<int>::try_convert<long>(first, last, value);
     }
 };
 
@@ -87,7 +91,7 @@ struct argument<unsigned int>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<unsigned int>::convert(cmd, std::next(position), &stou, "unsigned int");
+        return numerical_argument<unsigned int>::convert(cmd, std::next(position), &try_convert, "unsigned int");
     }
 
 
@@ -104,28 +108,24 @@ struct argument<unsigned int>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<unsigned int>::convert(cmd, position, &stou, "unsigned int");
+        return numerical_argument<unsigned int>::convert(cmd, position, &try_convert, "unsigned int");
     }
 
 
     /**
-     * @brief Convert a string to an unsigned long and return its unsigned int value.
+     * @brief Try to convert a character range to an unsigned int value without throwing.
+     *
+     * Follows the std::stoul() semantics, values outside of the unsigned int range are rejected.
      *
-     * @param s The string to convert to an unsigned int.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the unsigned int value on success.
      *
-     * @return The unsigned int value of the string passed.
-     * @throw std::out_of_range if the converted string value is outside of the range of the unsigned int type.
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static unsigned int stou(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, unsigned int &value)
     {
-        unsigned long result = std::stoul(s);
-
-        if (result > std::numeric_limits<unsigned int>::max())
-        {
-            throw std::out_of_range("stou");
-        }
-
-        return static_cast<unsigned int>(result);
+        return numerical_argument<unsigned int>::try_convert<unsigned long>(first, last, value);
     }
 };
 
@@ -32,7 +32,7 @@ struct argument<long>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<long>::convert(cmd, std::next(position), &wrap, "long");
+        return numerical_argument<long>::convert(cmd, std::next(position), &try_convert, "long");
     }
 
     /**
@@ -48,19 +48,23 @@ struct argument<long>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<long>::convert(cmd, position, &wrap, "long");
+        return numerical_argument<long>::convert(cmd, position, &try_convert, "long");
     }
 
     /**
-     * @brief Wrap std::stol() for use without default parameters.
+     * @brief Try to convert a character range to a long value without throwing.
      *
-     * @param s The string to convert to a long.
+     * Follows the std::stol() semantics.
      *
-     * @return The long value of the string passed.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the long value on success.
+     *
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static long wrap(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, long &value)
     {
-        return std::stol(s);
+        return numerical_argument<long>::try_convert<long>(first, last, value);
     }
 };
 
@@ -84,7 +88,7 @@ struct argument<long long>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<long long>::convert(cmd, std::next(position), &wrap, "long long");
+        return numerical_argument<long long>::convert(cmd, std::next(position), &try_convert, "long long");
     }
 
     /**
@@ -100,19 +104,23 @@ struct argument<long long>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<long long>::convert(cmd, position, &wrap, "long long");
+        return numerical_argument<long long>::convert(cmd, position, &try_convert, "long long");
     }
 
     /**
-     * @brief Wrap std::stoll() for use without default parameters.
+     * @brief Try to convert a character range to a long long value without throwing.
+     *
+     * Follows the std::stoll() semantics.
      *
-     * @param s The string to convert to a long long.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the long long value on success.
      *
-     * @return The long long value of the string passed.
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static long long wrap(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, long long &value)
     {
-        return std::stoll(s);
+        return numerical_argument<long long>::try_convert<long long>(first, last, value);
     }
 };
 
@@ -136,7 +144,7 @@ struct argument<unsigned long>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<unsigned long>::convert(cmd, std::next(position), &wrap, "unsigned long");
+        return numerical_argument<unsigned long>::convert(cmd, std::next(position), &try_convert, "unsigned long");
     }
 
     /**
@@ -152,19 +160,23 @@ struct argument<unsigned long>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<unsigned long>::convert(cmd, position, &wrap, "unsigned long");
+        return numerical_argument<unsigned long>::convert(cmd, position, &try_convert, "unsigned long");
     }
 
     /**
-     * @brief Wrap std::stoul() for use without default parameters.
+     * @brief Try to convert a character range to an unsigned long value without throwing.
      *
-     * @param s The string to convert to an unsigned long.
+     * Follows the std::stoul() semantics.
      *
-     * @return The unsigned long value of the string passed.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the unsigned long value on success.
+     *
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static unsigned long wrap(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, unsigned long &value)
     {
-        return std::stoul(s);
+        return numerical_argument<unsigned long>::try_convert<unsigned long>(first, last, value);
     }
 };
 
@@ -188,7 +200,7 @@ struct argument<unsigned long long>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<unsigned long long>::convert(cmd, std::next(position), &wrap, "unsigned long long");
+        return numerical_argument<unsigned long long>::convert(cmd, std::next(position), &try_convert, "unsigned long long");
     }
 
 
@@ -205,20 +217,24 @@ struct argument<unsigned long long>
             const cmd::CommandLinePosition_t &position,
             const cmd::CommandLineArguments_t &)
     {
-        return numerical_argument<unsigned long long>::convert(cmd, position, &wrap, "unsigned long long");
+        return numerical_argument<unsigned long long>::convert(cmd, position, &try_convert, "unsigned long long");
     }
 
 
     /**
-     * @brief Wrap std::stoull() for use without default parameters.
+     * @brief Try to convert a character range to an unsigned long long value without throwing.
+     *
+     * Follows the std::stoull() semantics.
      *
-     * @param s The string to convert to an unsigned long long.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the unsigned long long value on success.
      *
-     * @return The unsigned long long value of the string passed.
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
      */
-    static unsigned long long wrap(const std::string &s)
+    static errors::Code try_convert(const char *first, const char *last, unsigned long long &value)
     {
-        return std::stoull(s);
+        return numerical_argument<unsigned long long>::try_convert<unsigned long long>(first, last, value);
     }
 };
 
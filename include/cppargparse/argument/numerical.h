@@ -1,9 +1,12 @@
 #ifndef CPPARGPARSE_ARGUMENT_NUMERICAL_H
 #define CPPARGPARSE_ARGUMENT_NUMERICAL_H
 
-#include <functional>
-#include <sstream>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <type_traits>
 
 #include <cppargparse/cmd.h>
 #include <cppargparse/errors.h>
@@ -12,19 +15,122 @@
 namespace cppargparse {
 
 
+template <typename Parsed>
+/**
+ * @brief The C library conversion function (strtol(), strtod(), ...) for a numerical type.
+ *
+ * @tparam Parsed The type returned by the conversion function.
+ */
+struct strto;
+
+
+template <>
+/**
+ * @brief std::strtol() with base 10.
+ */
+struct strto<long>
+{
+    static long convert(const char *s, char **end)
+    {
+        return std::strtol(s, end, 10);
+    }
+};
+
+
+template <>
+/**
+ * @brief std::strtoul() with base 10.
+ */
+struct strto<unsigned long>
+{
+    static unsigned long convert(const char *s, char **end)
+    {
+        return std::strtoul(s, end, 10);
+    }
+};
+
+
+template <>
+/**
+ * @brief std::strtoll() with base 10.
+ */
+struct strto<long long>
+{
+    static long long convert(const char *s, char **end)
+    {
+        return std::strtoll(s, end, 10);
+    }
+};
+
+
+template <>
+/**
+ * @brief std::strtoull() with base 10.
+ */
+struct strto<unsigned long long>
+{
+    static unsigned long long convert(const char *s, char **end)
+    {
+        return std::strtoull(s, end, 10);
+    }
+};
+
+
+template <>
+/**
+ * @brief std::strtof().
+ */
+struct strto<float>
+{
+    static float convert(const char *s, char **end)
+    {
+        return std::strtof(s, end);
+    }
+};
+
+
+template <>
+/**
+ * @brief std::strtod().
+ */
+struct strto<double>
+{
+    static double convert(const char *s, char **end)
+    {
+        return std::strtod(s, end);
+    }
+};
+
+
+template <>
+/**
+ * @brief std::strtold().
+ */
+struct strto<long double>
+{
+    static long double convert(const char *s, char **end)
+    {
+        return std::strtold(s, end);
+    }
+};
+
+
 template <typename T>
 /**
  * @brief The conversion struct for numerical types.
  */
 struct numerical_argument
 {
+    template <typename Converter>
     /**
      * @brief Try to convert a command line argument value to a numerical value.
      *
+     * @tparam Converter errors::Code(const char *first, const char *last, T &value)
+     *
      * @param cmd The command line.
      * @param position The command line argument iterator.
      * @param numerical_converter The function used to convert the cmdarg into a numerical value.
-     * @param type_string The numerical type's string representation.
+     * @param type_name The numerical type's name, a string literal.
      *
      * @return The numerical value of the command line argument.
      * @throws #cppargparse::errors::CommandLineOptionError if the conversion was unsuccessful.
@@ -32,45 +138,143 @@ struct numerical_argument
     static T convert(
             const cmd::CommandLine_t &cmd,
             const cmd::CommandLinePosition_t &position,
-            const std::function<T(const std::string &)> &numerical_converter,
-            const std::string &type_string)
+            Converter numerical_converter,
+            const char *type_name)
     {
         if (position == cmd.cend())
         {
-            throw errors::CommandLineOptionError(error_message(std::prev(position), type_string));
+            errors::raise<errors::CommandLineOptionError>(error(cmd, std::prev(position), errors::Code::MissingValue, type_name));
         }
 
-        try
+        T value;
+        const errors::Code code = numerical_converter(position->data(), position->data() + position->size(), value);
+
+        if (code != errors::Code::None)
         {
-            return numerical_converter(*position);
+            errors::raise<errors::CommandLineOptionError>(error(cmd, position, code, type_name));
         }
 
-        catch (const std::invalid_argument &)
+        return value;
+    }
+
+
+    template <typename Parsed>
+    /**
+     * @brief Try to convert a character range to a numerical value without throwing.
+     *
+     * Follows the std::sto*() semantics: leading whitespace is skipped, trailing characters are ignored,
+     * values outside of the range of T are rejected.
+     *
+     * @tparam Parsed The type the C library converts to, see strto. Must be able to hold all values of T.
+     *
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the numerical value on success.
+     *
+     * @return errors::Code::None, errors::Code::InvalidValue or errors::Code::OutOfRange.
+     */
+    static errors::Code try_convert(const char *first, const char *last, T &value)
+    {
+        // The C library needs a NUL-terminated string, numbers fit into the stack buffer
+        char buffer[64];
+        std::string fallback;
+        const char *s = buffer;
+        const size_t size = static_cast<size_t>(last - first);
+
+        if (size < sizeof(buffer))
+        {
+            std::memcpy(buffer, first, size);
+            buffer[size] = '\0';
+        }
+        else
         {
-            throw errors::CommandLineOptionError(error_message(position, type_string));
+            fallback.assign(first, last);
+            s = fallback.c_str();
         }
-        catch (const std::out_of_range &)
+
+        const int saved_errno = errno;
+        errno = 0;
+
+        char *end;
+        const Parsed parsed = strto<Parsed>::convert(s, &end);
+        const bool out_of_range = (errno == ERANGE);
+
+        if (errno == 0)
+        {
+            errno = saved_errno;
+        }
+
+        if (end == s)
         {
-            throw errors::CommandLineOptionError(error_message(position, type_string));
+            return errors::Code::InvalidValue;
         }
+
+        if (out_of_range || !in_range(parsed))
+        {
+            return errors::Code::OutOfRange;
+        }
+
+        value = static_cast<T>(parsed);
+
+        return errors::Code::None;
     }
 
 
     /**
-     * @brief Generate an error message for a value that's not a numerical value.
+     * @brief Create the error for a value that's not convertible to a numerical type.
+     *
+     * The message is only formatted if it is requested.
      *
-     * @param position The command line argument iterator position.
-     * @param type_string The numerical type's string representation.
+     * @param cmd The command line.
+     * @param position The command line argument iterator position of the offending token.
+     * @param code The error code.
+     * @param type_name The numerical type's name, a string literal.
      *
-     * @return An error message for a value that's not convertible to the specified numerical type.
+     * @return The error.
+     */
+    static errors::CommandLineOptionError error(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const errors::Code code,
+            const char *type_name)
+    {
+        return errors::CommandLineOptionError(
+                code, static_cast<size_t>(position - cmd.cbegin()), type_name, position->data(), position->size());
+    }
+
+
+private:
+    template <typename Parsed>
+    /**
+     * @brief Internal: Return whether a signed integer fits into T.
      */
-    static const std::string error_message(const cmd::CommandLinePosition_t &position, const std::string &type_string)
+    static typename std::enable_if<std::is_integral<Parsed>::value && std::is_signed<Parsed>::value, bool>::type
+    in_range(const Parsed parsed)
     {
-        std::ostringstream message;
-        message << "Couldn't convert '" << *position << "' to type <" << type_string << ">.";
-        std::string x = message.str();
+        return parsed >= static_cast<Parsed>(std::numeric_limits<T>::min())
+            && parsed <= static_cast<Parsed>(std::numeric_limits<T>::max());
+    }
+
 
-        return message.str();
+    template <typename Parsed>
+    /**
+     * @brief Internal: Return whether an unsigned integer fits into T.
+     */
+    static typename std::enable_if<std::is_integral<Parsed>::value && std::is_unsigned<Parsed>::value, bool>::type
+    in_range(const Parsed parsed)
+    {
+        return parsed <= static_cast<Parsed>(std::numeric_limits<T>::max());
+    }
+
+
+    template <typename Parsed>
+    /**
+     * @brief Internal: Floating point values are converted to their own type, range errors are reported by errno.
+     */
+    static typename std::enable_if<std::is_floating_point<Parsed>::value, bool>::type
+    in_range(const Parsed)
+    {
+        return true;
     }
 };
 
@@ -0,0 +1,142 @@
+#ifndef CPPARGPARSE_ARGUMENT_PATH_H
+#define CPPARGPARSE_ARGUMENT_PATH_H
+
+#include <string>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/io.h>
+
+#include "argument.h"
+#include "string.h"
+
+
+namespace cppargparse {
+
+
+template <>
+/**
+ * @brief The argument struct for the io::Path type.
+ */
+struct argument<io::Path>
+{
+    /**
+     * @brief Try to parse a command line argument as a path.
+     *
+     * @param cmd The command line.
+     * @param position The command line argument iterator.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The path value of the command line argument next in line.
+     */
+    static const io::Path parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return convert(cmd, std::next(position), cmdargs);
+    }
+
+
+    /**
+     * @brief Try to convert a command line argument to a path.
+     *
+     * @param cmd The command line.
+     * @param position The command line argument iterator.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The path value of the command line argument.
+     * @throws #cppargparse::errors::CommandLineOptionError if there is no value to parse.
+     */
+    static const io::Path convert(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return io::Path(argument<std::string>::convert(cmd, position, cmdargs));
+    }
+
+
+    /**
+     * @brief Try to convert a character range to a path without throwing.
+     *
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the path.
+     *
+     * @return errors::Code::None.
+     */
+    static errors::Code try_convert(const char *first, const char *last, io::Path &value)
+    {
+        value = io::Path(std::string(first, last));
+        return errors::Code::None;
+    }
+};
+
+
+template <>
+/**
+ * @brief The argument struct for the io::PrefetchedPath type.
+ *
+ * Converting a value advises the kernel to read the file ahead, once per file: converting a path again
+ * while a value for it exists shares that value's advised file.
+ */
+struct argument<io::PrefetchedPath>
+{
+    /**
+     * @brief Try to parse a command line argument as a path and start reading its file ahead.
+     *
+     * @param cmd The command line.
+     * @param position The command line argument iterator.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The path value of the command line argument next in line.
+     */
+    static const io::PrefetchedPath parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return convert(cmd, std::next(position), cmdargs);
+    }
+
+
+    /**
+     * @brief Try to convert a command line argument to a path and start reading its file ahead.
+     *
+     * @param cmd The command line.
+     * @param position The command line argument iterator.
+     * @param cmdargs The command line arguments.
+     *
+     * @return The path value of the command line argument.
+     * @throws #cppargparse::errors::CommandLineOptionError if there is no value to parse.
+     */
+    static const io::PrefetchedPath convert(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return io::PrefetchedPath(argument<std::string>::convert(cmd, position, cmdargs));
+    }
+
+
+    /**
+     * @brief Try to convert a character range to a path and start reading its file ahead without throwing.
+     *
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the path.
+     *
+     * @return errors::Code::None.
+     */
+    static errors::Code try_convert(const char *first, const char *last, io::PrefetchedPath &value)
+    {
+        value = io::PrefetchedPath(std::string(first, last));
+        return errors::Code::None;
+    }
+};
+
+
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGUMENT_PATH_H
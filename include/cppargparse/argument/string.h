@@ -2,7 +2,6 @@
 #define CPPARGPARSE_ARGUMENT_STRING_H
 
 #include <algorithm>
-#include <sstream>
 #include <string>
 
 #include <cppargparse/cmd.h>
@@ -54,7 +53,9 @@ struct argument<std::string>
     {
         if (position == cmd.cend())
         {
-            throw errors::CommandLineOptionError(error_message(std::prev(position)));
+            errors::raise<errors::CommandLineOptionError>(
+                    errors::Code::MissingValue, static_cast<size_t>(std::prev(position) - cmd.cbegin()), "std::string",
+                    std::prev(position)->data(), std::prev(position)->size());
         }
 
         return *position;
@@ -62,18 +63,18 @@ struct argument<std::string>
 
 
     /**
-     * @brief Generate an error message for a value that's not a std::string.
+     * @brief Try to convert a character range to a std::string without throwing.
      *
-     * @param position The command line argument iterator.
+     * @param first The start of the range.
+     * @param last The end of the range.
+     * @param value Receives the characters of the range.
      *
-     * @return An error message for a value that's not a std::string.
+     * @return errors::Code::None.
      */
-    static const char *error_message(const cmd::CommandLinePosition_t &position)
+    static errors::Code try_convert(const char *first, const char *last, std::string &value)
     {
-        std::ostringstream message;
-        message << "Couldn't convert " << *position << "to type <std::string>.";
-
-        return message.str().c_str();
+        value.assign(first, last);
+        return errors::Code::None;
     }
 };
 
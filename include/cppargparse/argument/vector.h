@@ -1,6 +1,7 @@
 #ifndef CPPARGPARSE_ARGUMENT_VECTOR_H
 #define CPPARGPARSE_ARGUMENT_VECTOR_H
 
+#include <cstddef>
 #include <vector>
 
 #include <cppargparse/algorithm.h>
@@ -12,6 +13,19 @@
 namespace cppargparse {
 
 
+/**
+ * @brief The result of parsing a vector argument into caller-provided storage.
+ */
+struct fill_result
+{
+    /// The number of values written to the caller's storage.
+    size_t written;
+
+    /// Whether the command line holds more values than the caller's storage could take.
+    bool truncated;
+};
+
+
 template <typename T>
 /**
  * @brief The argument struct for the std::vector<T> type.
@@ -44,6 +58,54 @@ struct argument<std::vector<T>>
 
         return values;
     }
+
+
+    template <typename OutputIt>
+    /**
+     * @brief Try to parse the typed values for the vector argument into caller-provided storage.
+     *
+     * Values are converted one by one and written to @p out, no intermediate container is built.
+     *
+     * @tparam OutputIt The output iterator type. Must accept values of type T.
+     *
+     * @param cmd The command line.
+     * @param position The command line argument iterator.
+     * @param cmdargs The command line arguments.
+     * @param out The output iterator to write the values to.
+     * @param capacity The maximum number of values to write.
+     *
+     * @return The number of values written and whether there were more values than @p capacity.
+     */
+    static fill_result parse_into(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs,
+            OutputIt out,
+            const size_t capacity)
+    {
+        fill_result result {0, false};
+
+        for (auto current = std::next(position); current != cmd.cend(); ++current)
+        {
+            if (algorithm::is_arg_token(cmdargs, *current))
+            {
+                break;
+            }
+
+            if (result.written == capacity)
+            {
+                result.truncated = true;
+                break;
+            }
+
+            *out = argument<T>::convert(cmd, current, cmdargs);
+
+            ++out;
+            ++result.written;
+        }
+
+        return result;
+    }
 };
 
 
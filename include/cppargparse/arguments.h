@@ -13,6 +13,7 @@
 #include <cppargparse/argument/float.h>
 #include <cppargparse/argument/int.h>
 #include <cppargparse/argument/long.h>
+#include <cppargparse/argument/path.h>
 #include <cppargparse/argument/string.h>
 #include <cppargparse/argument/vector.h>
 
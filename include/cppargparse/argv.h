@@ -0,0 +1,707 @@
+#ifndef CPPARGPARSE_ARGV_H
+#define CPPARGPARSE_ARGV_H
+
+/**
+  @file cppargparse/argv.h
+  @brief Building argument vectors for child processes (execve, posix_spawn).
+ */
+
+
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/parser.h>
+
+
+namespace cppargparse {
+namespace argv {
+
+
+/**
+ * @brief The maximum number of characters to_chars() writes for a single arithmetic value.
+ */
+constexpr size_t max_chars = 64;
+
+
+template <typename T>
+/**
+ * @brief Format an unsigned integer into a character range.
+ *
+ * @param first The start of the range.
+ * @param last The end of the range.
+ * @param value The value to format.
+ *
+ * @return One past the last written character or nullptr if the range is too small.
+ */
+inline typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, char *>::type
+to_chars(char *first, char *last, T value)
+{
+    char digits[std::numeric_limits<T>::digits10 + 1];
+    char *digit = digits + sizeof(digits);
+
+    do
+    {
+        *--digit = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    while (value != 0);
+
+    const size_t length = static_cast<size_t>(digits + sizeof(digits) - digit);
+
+    if (static_cast<size_t>(last - first) < length)
+    {
+        return nullptr;
+    }
+
+    std::memcpy(first, digit, length);
+
+    return first + length;
+}
+
+
+template <typename T>
+/**
+ * @brief Format a signed integer into a character range.
+ *
+ * @param first The start of the range.
+ * @param last The end of the range.
+ * @param value The value to format.
+ *
+ * @return One past the last written character or nullptr if the range is too small.
+ */
+inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, char *>::type
+to_chars(char *first, char *last, const T value)
+{
+    typedef typename std::make_unsigned<T>::type unsigned_t;
+
+    if (value >= 0)
+    {
+        return to_chars(first, last, static_cast<unsigned_t>(value));
+    }
+
+    if (first == last)
+    {
+        return nullptr;
+    }
+
+    *first = '-';
+
+    return to_chars(first + 1, last, static_cast<unsigned_t>(0 - static_cast<unsigned_t>(value)));
+}
+
+
+template <typename T>
+/**
+ * @brief Format a floating point number into a character range.
+ *
+ * Uses the shortest %g representation which round-trips through the numerical converters, e.g. "0.1" for 0.1:
+ * starts with std::numeric_limits<T>::digits10 significant digits and adds digits up to max_digits10 until
+ * parsing the text yields the value again.
+ *
+ * @param first The start of the range.
+ * @param last The end of the range.
+ * @param value The value to format.
+ *
+ * @return One past the last written character or nullptr if the range is too small.
+ */
+inline typename std::enable_if<std::is_floating_point<T>::value, char *>::type
+to_chars(char *first, char *last, const T value)
+{
+    char buffer[max_chars];
+    int length = -1;
+
+    for (int precision = std::numeric_limits<T>::digits10; precision <= std::numeric_limits<T>::max_digits10; ++precision)
+    {
+        length = std::snprintf(buffer, sizeof(buffer), "%.*Lg", precision, static_cast<long double>(value));
+
+        // NaN never compares equal, infinities round-trip right away
+        if (length < 0 || value != value || strto<T>::convert(buffer, nullptr) == value)
+        {
+            break;
+        }
+    }
+
+    if (length < 0 || static_cast<size_t>(last - first) < static_cast<size_t>(length))
+    {
+        return nullptr;
+    }
+
+    std::memcpy(first, buffer, static_cast<size_t>(length));
+
+    return first + length;
+}
+
+
+/**
+ * @brief Format a boolean as "true" or "false".
+ *
+ * @param first The start of the range.
+ * @param last The end of the range.
+ * @param value The value to format.
+ *
+ * @return One past the last written character or nullptr if the range is too small.
+ */
+inline char *to_chars(char *first, char *last, const bool value)
+{
+    const char *text = value ? "true" : "false";
+    const size_t length = value ? 4 : 5;
+
+    if (static_cast<size_t>(last - first) < length)
+    {
+        return nullptr;
+    }
+
+    std::memcpy(first, text, length);
+
+    return first + length;
+}
+
+
+/**
+ * @brief Format a character as itself, matching the char argument converter.
+ *
+ * @param first The start of the range.
+ * @param last The end of the range.
+ * @param value The value to format.
+ *
+ * @return One past the last written character or nullptr if the range is too small.
+ */
+inline char *to_chars(char *first, char *last, const char value)
+{
+    if (first == last)
+    {
+        return nullptr;
+    }
+
+    *first = value;
+
+    return first + 1;
+}
+
+
+/**
+ * @brief Format an unsigned character as itself, matching the unsigned char argument converter.
+ *
+ * @param first The start of the range.
+ * @param last The end of the range.
+ * @param value The value to format.
+ *
+ * @return One past the last written character or nullptr if the range is too small.
+ */
+inline char *to_chars(char *first, char *last, const unsigned char value)
+{
+    return to_chars(first, last, static_cast<char>(value));
+}
+
+
+class Builder;
+
+
+/**
+ * @brief A NULL-terminated argument vector in a single contiguous allocation.
+ *
+ * The pointer table is followed by the NUL-terminated tokens it points to. Copies rebase the
+ * pointers onto their own allocation, so an Argv can be used as a template and stamped per child.
+ */
+class Argv
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * Creates an empty argument vector.
+     */
+    Argv()
+        : Argv(0, 0)
+    {
+    }
+
+
+    /**
+     * @brief Copy c'tor
+     *
+     * One allocation, one copy of the tokens and one pass to rebase the pointers.
+     *
+     * @param other The argument vector to copy.
+     */
+    Argv(const Argv &other)
+        : Argv(other.m_argc, other.m_bytes)
+    {
+        std::memcpy(bytes(), other.bytes(), m_bytes);
+
+        for (size_t i = 0; i < m_argc; ++i)
+        {
+            m_storage[i] = bytes() + (other.m_storage[i] - other.bytes());
+        }
+    }
+
+
+    /**
+     * @brief Move c'tor
+     *
+     * @param other The argument vector to move from.
+     */
+    Argv(Argv &&other)
+        : Argv()
+    {
+        swap(other);
+    }
+
+
+    /**
+     * @brief Copy assignment
+     *
+     * @param other The argument vector to copy.
+     *
+     * @return This argument vector.
+     */
+    Argv &operator=(const Argv &other)
+    {
+        Argv copy(other);
+        swap(copy);
+
+        return *this;
+    }
+
+
+    /**
+     * @brief Move assignment
+     *
+     * @param other The argument vector to move from.
+     *
+     * @return This argument vector.
+     */
+    Argv &operator=(Argv &&other)
+    {
+        swap(other);
+
+        return *this;
+    }
+
+
+    /**
+     * @brief Swap two argument vectors.
+     *
+     * @param other The other argument vector.
+     */
+    void swap(Argv &other)
+    {
+        std::swap(m_storage, other.m_storage);
+        std::swap(m_argc, other.m_argc);
+        std::swap(m_bytes, other.m_bytes);
+    }
+
+
+    /**
+     * @brief Return the NULL-terminated argument vector, e.g. for execve() or posix_spawn().
+     *
+     * @return The argument vector.
+     */
+    char **data()
+    {
+        return m_storage.get();
+    }
+
+
+    /**
+     * @brief Return the NULL-terminated argument vector, e.g. for execve() or posix_spawn().
+     *
+     * @return The argument vector.
+     */
+    char *const *data() const
+    {
+        return m_storage.get();
+    }
+
+
+    /**
+     * @brief Return the number of arguments (argc).
+     *
+     * @return The number of arguments.
+     */
+    size_t size() const
+    {
+        return m_argc;
+    }
+
+
+    /**
+     * @brief Return an argument.
+     *
+     * @param index The argument index.
+     *
+     * @return The NUL-terminated argument.
+     */
+    const char *operator[](const size_t index) const
+    {
+        return m_storage[index];
+    }
+
+
+    /**
+     * @brief Return a copy with some arguments replaced.
+     *
+     * The copy takes one allocation, the unchanged runs of tokens are copied with memcpy.
+     *
+     * @param replacements The argument indexes and their new values. For duplicate indexes, the last one wins.
+     *
+     * @return The stamped argument vector.
+     * @throws std::out_of_range if an index is not less than size().
+     */
+    Argv stamp(const std::initializer_list<std::pair<size_t, cmd::TokenView>> replacements) const
+    {
+        return stamp(replacements.begin(), replacements.end());
+    }
+
+
+    /**
+     * @brief Return a copy with one argument replaced.
+     *
+     * @param index The argument index.
+     * @param value The new value.
+     *
+     * @return The stamped argument vector.
+     * @throws std::out_of_range if the index is not less than size().
+     */
+    Argv stamp(const size_t index, const cmd::TokenView value) const
+    {
+        const std::pair<size_t, cmd::TokenView> replacement(index, value);
+        return stamp(&replacement, &replacement + 1);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return a copy with one argument replaced by a formatted arithmetic value.
+     *
+     * @tparam T The arithmetic value type. to_chars() must be implemented for T.
+     *
+     * @param index The argument index.
+     * @param value The new value.
+     *
+     * @return The stamped argument vector.
+     * @throws std::out_of_range if the index is not less than size().
+     */
+    typename std::enable_if<std::is_arithmetic<T>::value, Argv>::type stamp(const size_t index, const T value) const
+    {
+        char buffer[max_chars];
+        char *end = to_chars(buffer, buffer + sizeof(buffer), value);
+
+        return stamp(index, cmd::TokenView(buffer, static_cast<size_t>(end - buffer)));
+    }
+
+
+private:
+    friend class Builder;
+
+
+    /**
+     * @brief Internal: c'tor
+     *
+     * Allocates the pointer table and the token bytes in one block.
+     *
+     * @param argc The number of arguments.
+     * @param bytes The number of token bytes, including the NUL terminators.
+     */
+    Argv(const size_t argc, const size_t bytes)
+        : m_storage(new char *[argc + 1 + (bytes + sizeof(char *) - 1) / sizeof(char *)])
+        , m_argc(argc)
+        , m_bytes(bytes)
+    {
+        m_storage[argc] = nullptr;
+    }
+
+
+    /**
+     * @brief Internal: Return the token bytes behind the pointer table.
+     *
+     * @return The token bytes.
+     */
+    char *bytes() const
+    {
+        return reinterpret_cast<char *>(m_storage.get() + m_argc + 1);
+    }
+
+
+    /**
+     * @brief Internal: Return a copy with some arguments replaced.
+     *
+     * @param first The first replacement.
+     * @param last One past the last replacement.
+     *
+     * @return The stamped argument vector.
+     * @throws std::out_of_range if an index is not less than size().
+     */
+    Argv stamp(const std::pair<size_t, cmd::TokenView> *first, const std::pair<size_t, cmd::TokenView> *last) const
+    {
+        std::vector<const cmd::TokenView *> values(m_argc, nullptr);
+        size_t size = m_bytes;
+
+        for (auto replacement = first; replacement != last; ++replacement)
+        {
+            if (replacement->first >= m_argc)
+            {
+                errors::raise<std::out_of_range>("Argv index out of range: " + std::to_string(replacement->first));
+            }
+
+            const cmd::TokenView *&value = values[replacement->first];
+            size -= value ? value->size() : std::strlen(m_storage[replacement->first]);
+            size += replacement->second.size();
+            value = &replacement->second;
+        }
+
+        Argv stamped(m_argc, size);
+
+        const char *run = bytes();
+        char *out = stamped.bytes();
+
+        for (size_t i = 0; i < m_argc; ++i)
+        {
+            if (!values[i])
+            {
+                stamped.m_storage[i] = out + (m_storage[i] - run);
+                continue;
+            }
+
+            // Flush the unchanged run before the replaced token
+            const size_t run_size = static_cast<size_t>(m_storage[i] - run);
+            std::memcpy(out, run, run_size);
+            out += run_size;
+
+            stamped.m_storage[i] = out;
+            std::memcpy(out, values[i]->data(), values[i]->size());
+            out += values[i]->size();
+            *out++ = '\0';
+
+            run = m_storage[i] + std::strlen(m_storage[i]) + 1;
+        }
+
+        std::memcpy(out, run, static_cast<size_t>(bytes() + m_bytes - run));
+
+        return stamped;
+    }
+
+
+    /// The pointer table, followed by the token bytes
+    std::unique_ptr<char *[]> m_storage;
+
+    /// The number of arguments
+    size_t m_argc;
+
+    /// The number of token bytes
+    size_t m_bytes;
+};
+
+
+/**
+ * @brief Collects tokens for an argument vector.
+ *
+ * Example:
+ * @code
+ * argv::Builder builder;
+ * builder.append("worker").forward(arg_parser, threads).option(id, 0);
+ * const argv::Argv argv = builder.build();
+ *
+ * // argv[4] is the value of --id
+ * ::posix_spawn(&pid, path, nullptr, nullptr, argv.stamp(4, child).data(), environ);
+ * @endcode
+ */
+class Builder
+{
+public:
+    /**
+     * @brief c'tor
+     */
+    Builder()
+        : m_bytes()
+        , m_offsets()
+    {
+    }
+
+
+    /**
+     * @brief Append a token.
+     *
+     * @param token The token.
+     *
+     * @return This builder.
+     */
+    Builder &append(const cmd::TokenView token)
+    {
+        m_offsets.emplace_back(m_bytes.size());
+        m_bytes.append(token.data(), token.size());
+        m_bytes.push_back('\0');
+
+        return *this;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Append a formatted arithmetic value.
+     *
+     * @tparam T The arithmetic value type. to_chars() must be implemented for T.
+     *
+     * @param value The value.
+     *
+     * @return This builder.
+     */
+    typename std::enable_if<std::is_arithmetic<T>::value, Builder &>::type append(const T value)
+    {
+        char buffer[max_chars];
+        char *end = to_chars(buffer, buffer + sizeof(buffer), value);
+
+        return append(cmd::TokenView(buffer, static_cast<size_t>(end - buffer)));
+    }
+
+
+    /**
+     * @brief Append an option without a value, e.g. a flag.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return This builder.
+     */
+    Builder &option(const cmd::CommandLineArgument &cmdarg)
+    {
+        return append(cmdarg.id());
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Append an option with a value, e.g. to override a parsed one.
+     *
+     * @tparam T The value type. A string or an arithmetic type.
+     *
+     * @param cmdarg The command line argument.
+     * @param value The value.
+     *
+     * @return This builder.
+     */
+    Builder &option(const cmd::CommandLineArgument &cmdarg, const T &value)
+    {
+        return append(cmdarg.id()).append(value);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Append an option with multiple values.
+     *
+     * @tparam T The value type. A string or an arithmetic type.
+     *
+     * @param cmdarg The command line argument.
+     * @param values The values.
+     *
+     * @return This builder.
+     */
+    Builder &option(const cmd::CommandLineArgument &cmdarg, const std::vector<T> &values)
+    {
+        append(cmdarg.id());
+
+        for (const auto &value : values)
+        {
+            append(value);
+        }
+
+        return *this;
+    }
+
+
+    /**
+     * @brief Forward a parsed option and its values.
+     *
+     * Values supplied by any source (command line, environment, configuration file) are forwarded
+     * as they were given. Nothing is appended if the option has no value.
+     *
+     * @param arg_parser The argument parser.
+     * @param cmdarg The command line argument.
+     *
+     * @return This builder.
+     */
+    Builder &forward(parser::ArgumentParser &arg_parser, const cmd::CommandLineArgument &cmdarg)
+    {
+        if (arg_parser.get_source(cmdarg) != cmd::Source::Default)
+        {
+            option(cmdarg, arg_parser.get_option<std::vector<std::string>>(cmdarg));
+        }
+
+        return *this;
+    }
+
+
+    /**
+     * @brief Forward a parsed flag.
+     *
+     * @param arg_parser The argument parser.
+     * @param cmdarg The command line argument.
+     *
+     * @return This builder.
+     */
+    Builder &forward_flag(parser::ArgumentParser &arg_parser, const cmd::CommandLineArgument &cmdarg)
+    {
+        if (arg_parser.get_flag(cmdarg))
+        {
+            option(cmdarg);
+        }
+
+        return *this;
+    }
+
+
+    /**
+     * @brief Return the number of tokens.
+     *
+     * @return The number of tokens.
+     */
+    size_t size() const
+    {
+        return m_offsets.size();
+    }
+
+
+    /**
+     * @brief Build the argument vector.
+     *
+     * @return The argument vector.
+     */
+    Argv build() const
+    {
+        Argv argv(m_offsets.size(), m_bytes.size());
+
+        char *bytes = argv.bytes();
+        std::memcpy(bytes, m_bytes.data(), m_bytes.size());
+
+        for (size_t i = 0; i < m_offsets.size(); ++i)
+        {
+            argv.m_storage[i] = bytes + m_offsets[i];
+        }
+
+        return argv;
+    }
+
+
+private:
+    /// The NUL-terminated tokens
+    std::string m_bytes;
+
+    /// The token offsets into m_bytes
+    std::vector<size_t> m_offsets;
+};
+
+
+} // namespace argv
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ARGV_H
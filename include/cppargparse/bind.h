@@ -0,0 +1,669 @@
+#ifndef CPPARGPARSE_BIND_H
+#define CPPARGPARSE_BIND_H
+
+/**
+  @file cppargparse/bind.h
+  @brief Binding options to the fields of a user struct.
+ */
+
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cppargparse/arguments.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/result.h>
+
+
+namespace cppargparse {
+namespace bind {
+
+
+/**
+ * @brief The field index of tokens which aren't bound options.
+ */
+constexpr size_t npos = errors::npos;
+
+
+/**
+ * @brief Internal: Return the length of a NUL-terminated string at compile time.
+ */
+constexpr size_t length(const char *s)
+{
+    return *s ? 1 + length(s + 1) : 0;
+}
+
+
+/**
+ * @brief The default value type of options without a default value.
+ */
+struct NoDefault
+{
+};
+
+
+template <typename T>
+/**
+ * @brief Internal: Writes the values of an option into a field of type T.
+ *
+ * Scalar fields take the first value following the option.
+ */
+struct field_traits
+{
+    static_assert(result::has_try_convert<T>::value, "bind requires argument<T>::try_convert()");
+
+    /// Whether the option needs a value
+    static constexpr bool needs_value = true;
+
+    static const char *type_name()
+    {
+        return cppargparse::type_name<T>();
+    }
+
+    static void open(T &)
+    {
+    }
+
+    static errors::Code add(T &field, const cmd::TokenView &token, const size_t count)
+    {
+        return (count == 0) ? argument<T>::try_convert(token.data(), token.data() + token.size(), field) : errors::Code::None;
+    }
+};
+
+
+template <typename T>
+/**
+ * @brief Internal: Vector fields take all values up to the next option.
+ */
+struct field_traits<std::vector<T>>
+{
+    static_assert(result::has_try_convert<T>::value, "bind requires argument<T>::try_convert()");
+
+    /// Whether the option needs a value
+    static constexpr bool needs_value = false;
+
+    static const char *type_name()
+    {
+        return cppargparse::type_name<T>();
+    }
+
+    static void open(std::vector<T> &field)
+    {
+        field.clear();
+    }
+
+    static errors::Code add(std::vector<T> &field, const cmd::TokenView &token, const size_t)
+    {
+        field.emplace_back();
+
+        const errors::Code code = argument<T>::try_convert(token.data(), token.data() + token.size(), field.back());
+
+        if (code != errors::Code::None)
+        {
+            field.pop_back();
+        }
+
+        return code;
+    }
+};
+
+
+template <typename Struct, typename T, typename Default>
+/**
+ * @brief An option bound to a field, created by option().
+ *
+ * @tparam Struct The user struct.
+ * @tparam T The field type.
+ * @tparam Default The default value type, NoDefault if there is none.
+ */
+struct Option
+{
+    /// The option ID
+    const char *id;
+
+    /// The length of the option ID
+    size_t id_size;
+
+    /// The alternative option ID, empty if there is none
+    const char *id_alt;
+
+    /// The length of the alternative option ID
+    size_t id_alt_size;
+
+    /// The field
+    T Struct::*member;
+
+    /// The default value
+    Default default_value;
+
+
+    /**
+     * @brief Return whether a token is the option.
+     */
+    bool matches(const cmd::TokenView &token) const
+    {
+        return (token.size() == id_size && std::memcmp(token.data(), id, id_size) == 0)
+            || (id_alt_size != 0 && token.size() == id_alt_size && std::memcmp(token.data(), id_alt, id_alt_size) == 0);
+    }
+
+
+    /**
+     * @brief Write the default value into the field, if there is one.
+     */
+    void reset(Struct &object) const
+    {
+        assign(object.*member, default_value);
+    }
+
+
+    /**
+     * @brief The option has been passed.
+     */
+    void open(Struct &object) const
+    {
+        field_traits<T>::open(object.*member);
+    }
+
+
+    /**
+     * @brief Convert the value with index @p count following the option into the field.
+     */
+    errors::Code add(Struct &object, const cmd::TokenView &token, const size_t count) const
+    {
+        return field_traits<T>::add(object.*member, token, count);
+    }
+
+
+    /**
+     * @brief Return whether the option needs a value.
+     */
+    static constexpr bool needs_value()
+    {
+        return field_traits<T>::needs_value;
+    }
+
+
+    /**
+     * @brief Return the type name reported by conversion errors.
+     */
+    static const char *type_name()
+    {
+        return field_traits<T>::type_name();
+    }
+
+
+private:
+    template <typename D>
+    static void assign(T &field, const D &value)
+    {
+        field = value;
+    }
+
+    static void assign(T &, const NoDefault &)
+    {
+    }
+};
+
+
+template <typename Struct>
+/**
+ * @brief A flag bound to a bool field, created by flag(). The field is set to whether the flag has been passed.
+ *
+ * @tparam Struct The user struct.
+ */
+struct Flag
+{
+    /// The flag ID
+    const char *id;
+
+    /// The length of the flag ID
+    size_t id_size;
+
+    /// The alternative flag ID, empty if there is none
+    const char *id_alt;
+
+    /// The length of the alternative flag ID
+    size_t id_alt_size;
+
+    /// The field
+    bool Struct::*member;
+
+
+    /**
+     * @brief Return whether a token is the flag.
+     */
+    bool matches(const cmd::TokenView &token) const
+    {
+        return (token.size() == id_size && std::memcmp(token.data(), id, id_size) == 0)
+            || (id_alt_size != 0 && token.size() == id_alt_size && std::memcmp(token.data(), id_alt, id_alt_size) == 0);
+    }
+
+
+    /**
+     * @brief Clear the field.
+     */
+    void reset(Struct &object) const
+    {
+        object.*member = false;
+    }
+
+
+    /**
+     * @brief The flag has been passed.
+     */
+    void open(Struct &object) const
+    {
+        object.*member = true;
+    }
+
+
+    /**
+     * @brief Tokens following a flag are ignored.
+     */
+    errors::Code add(Struct &, const cmd::TokenView &, const size_t) const
+    {
+        return errors::Code::None;
+    }
+
+
+    /**
+     * @brief Return whether the flag needs a value.
+     */
+    static constexpr bool needs_value()
+    {
+        return false;
+    }
+
+
+    /**
+     * @brief Return the type name reported by conversion errors.
+     */
+    static const char *type_name()
+    {
+        return "bool";
+    }
+};
+
+
+template <typename Struct, typename T>
+/**
+ * @brief Bind an option to a field.
+ *
+ * @param id The option ID.
+ * @param member The field.
+ *
+ * @return The option binding.
+ */
+constexpr Option<Struct, T, NoDefault> option(const char *id, T Struct::*member)
+{
+    return Option<Struct, T, NoDefault> {id, length(id), "", 0, member, NoDefault()};
+}
+
+
+template <typename Struct, typename T>
+/**
+ * @brief Bind an option to a field.
+ *
+ * @param id The option ID.
+ * @param id_alt The alternative option ID.
+ * @param member The field.
+ *
+ * @return The option binding.
+ */
+constexpr Option<Struct, T, NoDefault> option(const char *id, const char *id_alt, T Struct::*member)
+{
+    return Option<Struct, T, NoDefault> {id, length(id), id_alt, length(id_alt), member, NoDefault()};
+}
+
+
+template <typename Struct, typename T, typename Default>
+/**
+ * @brief Bind an option with a default value to a field.
+ *
+ * @param id The option ID.
+ * @param member The field.
+ * @param default_value The default value, assignable to the field. Use a string literal for std::string fields
+ *                      to keep the binding table a compile-time constant.
+ *
+ * @return The option binding.
+ */
+constexpr Option<Struct, T, Default> option(const char *id, T Struct::*member, const Default default_value)
+{
+    return Option<Struct, T, Default> {id, length(id), "", 0, member, default_value};
+}
+
+
+template <typename Struct, typename T, typename Default>
+/**
+ * @brief Bind an option with a default value to a field.
+ *
+ * @param id The option ID.
+ * @param id_alt The alternative option ID.
+ * @param member The field.
+ * @param default_value The default value, assignable to the field.
+ *
+ * @return The option binding.
+ */
+constexpr Option<Struct, T, Default> option(const char *id, const char *id_alt, T Struct::*member, const Default default_value)
+{
+    return Option<Struct, T, Default> {id, length(id), id_alt, length(id_alt), member, default_value};
+}
+
+
+template <typename Struct>
+/**
+ * @brief Bind a flag to a bool field.
+ *
+ * @param id The flag ID.
+ * @param member The field.
+ *
+ * @return The flag binding.
+ */
+constexpr Flag<Struct> flag(const char *id, bool Struct::*member)
+{
+    return Flag<Struct> {id, length(id), "", 0, member};
+}
+
+
+template <typename Struct>
+/**
+ * @brief Bind a flag to a bool field.
+ *
+ * @param id The flag ID.
+ * @param id_alt The alternative flag ID.
+ * @param member The field.
+ *
+ * @return The flag binding.
+ */
+constexpr Flag<Struct> flag(const char *id, const char *id_alt, bool Struct::*member)
+{
+    return Flag<Struct> {id, length(id), id_alt, length(id_alt), member};
+}
+
+
+template <typename Struct, typename... Fields>
+/**
+ * @brief A table of options and flags bound to the fields of a struct, created by make_binding().
+ *
+ * The table is a literal type: declared constexpr, it is built at compile time.
+ *
+ * Example:
+ * @code
+ * struct Config
+ * {
+ *     int threads;
+ *     std::string name;
+ *     bool verbose;
+ * };
+ *
+ * constexpr auto binding = bind::make_binding<Config>(
+ *         bind::option("-t", "--threads", &Config::threads, 4),
+ *         bind::option("-n", &Config::name, "unnamed"),
+ *         bind::flag("-v", &Config::verbose));
+ *
+ * Config config;
+ * binding.parse(argc - 1, argv + 1, config);
+ * @endcode
+ */
+class Binding;
+
+
+template <typename Struct>
+/**
+ * @brief Internal: The end of a binding table.
+ */
+class Binding<Struct>
+{
+public:
+    constexpr Binding()
+    {
+    }
+
+    void reset(Struct &) const
+    {
+    }
+
+    size_t find(const cmd::TokenView &, const size_t) const
+    {
+        return npos;
+    }
+
+    void open(const size_t, Struct &) const
+    {
+    }
+
+    errors::Code add(const size_t, Struct &, const cmd::TokenView &, const size_t) const
+    {
+        return errors::Code::None;
+    }
+
+    bool needs_value(const size_t) const
+    {
+        return false;
+    }
+
+    const char *id(const size_t) const
+    {
+        return "";
+    }
+
+    const char *type_name(const size_t) const
+    {
+        return "";
+    }
+};
+
+
+template <typename Struct, typename Head, typename... Tail>
+/**
+ * @brief Internal: A binding table with at least one entry.
+ */
+class Binding<Struct, Head, Tail...>
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param head The first binding.
+     * @param tail The remaining bindings.
+     */
+    constexpr Binding(const Head head, const Tail... tail)
+        : m_head(head)
+        , m_tail(tail...)
+    {
+    }
+
+
+    /**
+     * @brief Parse a command line into a struct, in a single pass.
+     *
+     * Fields with a default value are reset to it and flags are cleared first. Values are converted
+     * straight into the fields. As in ArgumentParser, the values of an option run up to the next option.
+     *
+     * @param argc The command line argument count.
+     * @param argv The command line argument array.
+     * @param object The struct to fill.
+     *
+     * @throws #cppargparse::errors::CommandLineOptionError if an option has no value or a value cannot be converted.
+     *         Its code() and position() describe the failure like those raised by ArgumentParser::get_option().
+     */
+    void parse(const int argc, const char *const *argv, Struct &object) const
+    {
+        parse_tokens(argc > 0 ? static_cast<size_t>(argc) : 0, [argv](const size_t index)
+        {
+            return cmd::TokenView(argv[index], std::strlen(argv[index]));
+        }, object);
+    }
+
+
+    /**
+     * @brief Parse a command line into a struct, in a single pass.
+     *
+     * @param cmd The command line.
+     * @param object The struct to fill.
+     *
+     * @throws #cppargparse::errors::CommandLineOptionError if an option has no value or a value cannot be converted.
+     */
+    void parse(const cmd::CommandLine_t &cmd, Struct &object) const
+    {
+        parse_tokens(cmd.size(), [&cmd](const size_t index)
+        {
+            return cmd::TokenView(cmd[index]);
+        }, object);
+    }
+
+
+    /**
+     * @brief Internal: Reset all fields.
+     */
+    void reset(Struct &object) const
+    {
+        m_head.reset(object);
+        m_tail.reset(object);
+    }
+
+
+    /**
+     * @brief Internal: Return the index of the binding matching a token, npos if there is none.
+     */
+    size_t find(const cmd::TokenView &token, const size_t offset = 0) const
+    {
+        return m_head.matches(token) ? offset : m_tail.find(token, offset + 1);
+    }
+
+
+    /**
+     * @brief Internal: The option with index @p field has been passed.
+     */
+    void open(const size_t field, Struct &object) const
+    {
+        field == 0 ? m_head.open(object) : m_tail.open(field - 1, object);
+    }
+
+
+    /**
+     * @brief Internal: Convert a value of the option with index @p field.
+     */
+    errors::Code add(const size_t field, Struct &object, const cmd::TokenView &token, const size_t count) const
+    {
+        return field == 0 ? m_head.add(object, token, count) : m_tail.add(field - 1, object, token, count);
+    }
+
+
+    /**
+     * @brief Internal: Return whether the option with index @p field needs a value.
+     */
+    bool needs_value(const size_t field) const
+    {
+        return field == 0 ? Head::needs_value() : m_tail.needs_value(field - 1);
+    }
+
+
+    /**
+     * @brief Internal: Return the ID of the option with index @p field.
+     */
+    const char *id(const size_t field) const
+    {
+        return field == 0 ? m_head.id : m_tail.id(field - 1);
+    }
+
+
+    /**
+     * @brief Internal: Return the type name of the option with index @p field.
+     */
+    const char *type_name(const size_t field) const
+    {
+        return field == 0 ? Head::type_name() : m_tail.type_name(field - 1);
+    }
+
+
+private:
+    template <typename TokenAt>
+    /**
+     * @brief Internal: Parse tokens into a struct.
+     *
+     * @tparam TokenAt cmd::TokenView(size_t index)
+     */
+    void parse_tokens(const size_t count, TokenAt token_at, Struct &object) const
+    {
+        reset(object);
+
+        size_t field = npos;
+        size_t position = 0;
+        size_t values = 0;
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            const cmd::TokenView token = token_at(index);
+            const size_t next = find(token);
+
+            if (next != npos)
+            {
+                close(field, position, values, token_at);
+
+                field = next;
+                position = index;
+                values = 0;
+
+                open(field, object);
+            }
+            else if (field != npos)
+            {
+                const errors::Code code = add(field, object, token, values++);
+
+                if (code != errors::Code::None)
+                {
+                    errors::raise<errors::CommandLineOptionError>(code, index, type_name(field), token.data(), token.size());
+                }
+            }
+        }
+
+        close(field, position, values, token_at);
+    }
+
+
+    template <typename TokenAt>
+    /**
+     * @brief Internal: Check that the option with index @p field got a value if it needs one.
+     */
+    void close(const size_t field, const size_t position, const size_t values, TokenAt token_at) const
+    {
+        if (field != npos && values == 0 && needs_value(field))
+        {
+            const cmd::TokenView token = token_at(position);
+            errors::raise<errors::CommandLineOptionError>(errors::Code::MissingValue, position, type_name(field), token.data(), token.size());
+        }
+    }
+
+
+    /// The first binding
+    Head m_head;
+
+    /// The remaining bindings
+    Binding<Struct, Tail...> m_tail;
+};
+
+
+template <typename Struct, typename... Fields>
+/**
+ * @brief Create a binding table.
+ *
+ * @tparam Struct The user struct.
+ *
+ * @param fields The bindings, created by option() and flag().
+ *
+ * @return The binding table.
+ */
+constexpr Binding<Struct, Fields...> make_binding(const Fields... fields)
+{
+    return Binding<Struct, Fields...>(fields...);
+}
+
+
+} // namespace bind
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_BIND_H
@@ -0,0 +1,176 @@
+#ifndef CPPARGPARSE_CACHE_H
+#define CPPARGPARSE_CACHE_H
+
+/**
+  @file cppargparse/cache.h
+  @brief Memoized converted option values, keyed by argument ID and target type.
+ */
+
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace cppargparse {
+namespace cache {
+
+
+/**
+ * @brief A type ID: the address of a per-type static object.
+ */
+typedef const void *TypeId_t;
+
+
+template <typename T>
+/**
+ * @brief Return the type ID of a type.
+ *
+ * @tparam T The type.
+ *
+ * @return The type ID, unique per type and stable for the lifetime of the program.
+ */
+inline TypeId_t type_id()
+{
+    static const char id = 0;
+    return &id;
+}
+
+
+/**
+ * @brief Converted values of options, one per argument ID and target type.
+ *
+ * Each argument ID and type holds at most one value, repeated lookups and stores replace it instead of
+ * adding entries. Values are stored behind shared pointers, so copies of the cache share them and
+ * references stay valid while entries are added. They are invalidated by clear().
+ */
+class Cache
+{
+public:
+    /**
+     * @brief c'tor
+     */
+    Cache()
+        : m_entries()
+    {
+    }
+
+
+    template <typename T, typename Tag = T>
+    /**
+     * @brief Return the cached value of an argument.
+     *
+     * @tparam T The value type.
+     * @tparam Tag The type the value is keyed by, T by default.
+     *
+     * @param id The argument ID.
+     *
+     * @return The cached value or nullptr if there is none.
+     */
+    const T *find(const std::string &id) const
+    {
+        const auto entries = m_entries.find(id);
+
+        if (entries == m_entries.cend())
+        {
+            return nullptr;
+        }
+
+        for (const auto &entry : entries->second)
+        {
+            if (entry.type == type_id<Tag>())
+            {
+                return static_cast<const T *>(entry.value.get());
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    template <typename T, typename Tag = T>
+    /**
+     * @brief Store the value of an argument, replacing a previously cached value of the same type.
+     *
+     * @tparam T The value type.
+     * @tparam Tag The type the value is keyed by, T by default.
+     *
+     * @param id The argument ID.
+     * @param value The value.
+     *
+     * @return The cached value.
+     */
+    const T &store(const std::string &id, T value)
+    {
+        std::shared_ptr<void> stored = std::make_shared<T>(std::move(value));
+        const T &result = *static_cast<const T *>(stored.get());
+
+        auto &entries = m_entries[id];
+
+        for (auto &entry : entries)
+        {
+            if (entry.type == type_id<Tag>())
+            {
+                entry.value = std::move(stored);
+                return result;
+            }
+        }
+
+        entries.push_back(Entry {type_id<Tag>(), std::move(stored)});
+
+        return result;
+    }
+
+
+    /**
+     * @brief Remove all cached values.
+     */
+    void clear()
+    {
+        m_entries.clear();
+    }
+
+
+    /**
+     * @brief Return the number of cached values.
+     *
+     * @return The number of cached values.
+     */
+    size_t size() const
+    {
+        size_t count = 0;
+
+        for (const auto &entries : m_entries)
+        {
+            count += entries.second.size();
+        }
+
+        return count;
+    }
+
+
+private:
+    /**
+     * @brief Internal: A cached value and its type ID.
+     */
+    struct Entry
+    {
+        /// The type ID
+        TypeId_t type;
+
+        /// The value
+        std::shared_ptr<void> value;
+    };
+
+
+    /// The cached values: argument ID -> values by type
+    std::unordered_map<std::string, std::vector<Entry>> m_entries;
+};
+
+
+} // namespace cache
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_CACHE_H
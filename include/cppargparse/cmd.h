@@ -7,6 +7,8 @@
  */
 
 
+#include <cstddef>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -35,6 +37,224 @@ typedef CommandLine_t::const_iterator CommandLinePosition_t;
 typedef std::vector<CommandLinePosition_t> CommandLinePositions_t;
 
 
+/**
+ * @brief A non-owning view of a command line token.
+ *
+ * Points into memory owned by someone else (argv, a mapped file, an input line),
+ * so a token can be inspected without copying it into a std::string.
+ */
+class TokenView
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * Creates an empty token view.
+     */
+    TokenView()
+        : m_data(nullptr)
+        , m_size(0)
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param data The first character of the token.
+     * @param size The token length.
+     */
+    TokenView(const char *data, const size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param token The token string. Must outlive the view.
+     */
+    TokenView(const std::string &token)
+        : m_data(token.data())
+        , m_size(token.size())
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param token The NUL-terminated token. Must outlive the view.
+     */
+    TokenView(const char *token)
+        : m_data(token)
+        , m_size(std::strlen(token))
+    {
+    }
+
+
+    /**
+     * @brief Return the first character of the token.
+     *
+     * @return The first character of the token.
+     */
+    const char *data() const
+    {
+        return m_data;
+    }
+
+
+    /**
+     * @brief Return the token length.
+     *
+     * @return The token length.
+     */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+
+    /**
+     * @brief Return whether the token is empty.
+     *
+     * @return Whether the token is empty.
+     */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+
+    /**
+     * @brief Return an iterator to the first character of the token.
+     *
+     * @return An iterator to the first character of the token.
+     */
+    const char *begin() const
+    {
+        return m_data;
+    }
+
+
+    /**
+     * @brief Return an iterator past the last character of the token.
+     *
+     * @return An iterator past the last character of the token.
+     */
+    const char *end() const
+    {
+        return m_data + m_size;
+    }
+
+
+    /**
+     * @brief Return a character of the token.
+     *
+     * @param index The character index. Must be less than size().
+     *
+     * @return The character at @p index.
+     */
+    char operator[](const size_t index) const
+    {
+        return m_data[index];
+    }
+
+
+    /**
+     * @brief Return a copy of the token.
+     *
+     * @return A copy of the token.
+     */
+    std::string str() const
+    {
+        return std::string(m_data, m_size);
+    }
+
+
+    /**
+     * @brief Return whether two tokens are equal.
+     *
+     * @param other The other token.
+     *
+     * @return Whether the tokens are equal.
+     */
+    bool operator==(const TokenView &other) const
+    {
+        return m_size == other.m_size && (m_size == 0 || std::memcmp(m_data, other.m_data, m_size) == 0);
+    }
+
+
+    /**
+     * @brief Return whether two tokens differ.
+     *
+     * @param other The other token.
+     *
+     * @return Whether the tokens differ.
+     */
+    bool operator!=(const TokenView &other) const
+    {
+        return !(*this == other);
+    }
+
+
+private:
+    /// The first character of the token.
+    const char *m_data;
+
+    /// The token length.
+    size_t m_size;
+};
+
+
+/**
+ * @brief Hash function for token views (FNV-1a).
+ */
+struct TokenViewHash
+{
+    /**
+     * @brief Hash a token view.
+     *
+     * @param token The token view.
+     *
+     * @return The hash value of the token's characters.
+     */
+    size_t operator()(const TokenView &token) const
+    {
+        size_t hash = static_cast<size_t>(14695981039346656037ull);
+
+        for (const char c : token)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= static_cast<size_t>(1099511628211ull);
+        }
+
+        return hash;
+    }
+};
+
+
+/**
+ * @brief The sources an argument value can be taken from, in order of precedence.
+ */
+enum class Source
+{
+    /// Passed to the command line.
+    CommandLine,
+
+    /// Read from an environment variable fallback.
+    Environment,
+
+    /// Read from the configuration file.
+    ConfigFile,
+
+    /// Not supplied by any source, a default value applies.
+    Default
+};
+
+
 /**
  * @brief The command line argument class.
  */
@@ -0,0 +1,441 @@
+#ifndef CPPARGPARSE_CONFIG_H
+#define CPPARGPARSE_CONFIG_H
+
+/**
+  @file cppargparse/config.h
+  @brief Configuration files as an argument source.
+ */
+
+
+#include <string>
+#include <unordered_map>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/io.h>
+
+
+namespace cppargparse {
+namespace config {
+
+
+/**
+ * @brief Return an argument ID without its leading dashes.
+ *
+ * Example: "--threads" -> "threads"
+ *
+ * @param id The argument ID.
+ *
+ * @return The configuration key for @p id.
+ */
+inline std::string key_of(const std::string &id)
+{
+    const size_t first = id.find_first_not_of('-');
+
+    return (first == std::string::npos) ? std::string() : id.substr(first);
+}
+
+
+/**
+ * @brief A parsed configuration file (INI/TOML subset).
+ *
+ * Supported syntax:
+ * @code
+ * # comment
+ * threads = 8
+ * name = "My Name"      # inline comment
+ * files = [a.txt, 'b c.txt', "d.txt"]
+ * verbose = true
+ *
+ * [server]
+ * port = 8080           # key: server.port
+ * @endcode
+ *
+ * Each key is stored as a small command line of the form (key, value, ...), so the registered
+ * argument<T> converters can be used on it as they are on the real command line.
+ * A key matches an argument whose ID or alternative ID equals the key after stripping leading dashes.
+ */
+class ConfigFile
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * Creates an empty configuration.
+     */
+    ConfigFile()
+        : m_entries()
+    {
+    }
+
+
+    /**
+     * @brief Load a configuration file, replacing any previously loaded one.
+     *
+     * The file is mapped into memory and parsed in a single pass.
+     *
+     * @param path The configuration file path.
+     *
+     * @throws #cppargparse::errors::ConfigFileError if the file cannot be read or contains a syntax error.
+     */
+    void load(const std::string &path)
+    {
+        std::string error;
+
+        if (!try_load(path, error))
+        {
+            errors::raise<errors::ConfigFileError>(error);
+        }
+    }
+
+
+    /**
+     * @brief Load a configuration file without raising errors, replacing any previously loaded one.
+     *
+     * @param path The configuration file path.
+     * @param error Receives the error message if the file cannot be read or contains a syntax error.
+     *
+     * @return Whether the file has been loaded. On syntax errors, the keys before the error have been added.
+     */
+    bool try_load(const std::string &path, std::string &error)
+    {
+        const io::MappedFile file(path);
+
+        if (!file.is_open())
+        {
+            error = "Cannot read configuration file: " + path;
+            return false;
+        }
+
+        m_entries.clear();
+        return try_parse(file.data(), file.data() + file.size(), error);
+    }
+
+
+    /**
+     * @brief Parse configuration text, adding its keys to the configuration.
+     *
+     * @param first The first character of the text.
+     * @param last The end of the text.
+     *
+     * @throws #cppargparse::errors::ConfigFileError on syntax errors.
+     */
+    void parse(const char *first, const char *last)
+    {
+        std::string error;
+
+        if (!try_parse(first, last, error))
+        {
+            errors::raise<errors::ConfigFileError>(error);
+        }
+    }
+
+
+    /**
+     * @brief Parse configuration text without raising errors, adding its keys to the configuration.
+     *
+     * @param first The first character of the text.
+     * @param last The end of the text.
+     * @param error Receives the error message on syntax errors.
+     *
+     * @return Whether the text has been parsed. On syntax errors, the keys before the error have been added.
+     */
+    bool try_parse(const char *first, const char *last, std::string &error)
+    {
+        std::string section;
+        size_t line = 1;
+
+        for (const char *position = first; position != last; ++line)
+        {
+            const char *end_of_line = position;
+
+            while (end_of_line != last && *end_of_line != '\n')
+            {
+                ++end_of_line;
+            }
+
+            const char *what = parse_line(skip_space(position, end_of_line), end_of_line, section);
+
+            if (what)
+            {
+                error = "Configuration line " + std::to_string(line) + ": " + what;
+                return false;
+            }
+
+            position = (end_of_line == last) ? last : end_of_line + 1;
+        }
+
+        return true;
+    }
+
+
+    /**
+     * @brief Return the configuration entry for an argument.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The entry command line (key, value, ...) or nullptr if the configuration doesn't contain the argument.
+     */
+    const cmd::CommandLine_t *find(const cmd::CommandLineArgument &cmdarg) const
+    {
+        const cmd::CommandLine_t *entry = find(key_of(cmdarg.id()));
+
+        if (!entry && !cmdarg.id_alt().empty())
+        {
+            entry = find(key_of(cmdarg.id_alt()));
+        }
+
+        return entry;
+    }
+
+
+    /**
+     * @brief Return the configuration entry for a key.
+     *
+     * @param key The key, e.g. "threads" or "server.port".
+     *
+     * @return The entry command line (key, value, ...) or nullptr if the configuration doesn't contain the key.
+     */
+    const cmd::CommandLine_t *find(const std::string &key) const
+    {
+        if (key.empty())
+        {
+            return nullptr;
+        }
+
+        const auto it = m_entries.find(key);
+
+        return (it == m_entries.cend()) ? nullptr : &it->second;
+    }
+
+
+    /**
+     * @brief Return the number of keys.
+     *
+     * @return The number of keys.
+     */
+    size_t size() const
+    {
+        return m_entries.size();
+    }
+
+
+private:
+    /**
+     * @brief Internal: Skip spaces and tabs.
+     *
+     * @param position The current position.
+     * @param last The end of the line.
+     *
+     * @return The first position that isn't a space or tab.
+     */
+    static const char *skip_space(const char *position, const char *last)
+    {
+        while (position != last && (*position == ' ' || *position == '\t' || *position == '\r'))
+        {
+            ++position;
+        }
+
+        return position;
+    }
+
+
+    /**
+     * @brief Internal: Parse a single line.
+     *
+     * @param position The first non-space character of the line.
+     * @param last The end of the line.
+     * @param section The current section. Updated for section headers.
+     *
+     * @return The syntax error description or nullptr if the line is valid.
+     */
+    const char *parse_line(const char *position, const char *last, std::string &section)
+    {
+        if (position == last || *position == '#' || *position == ';')
+        {
+            return nullptr;
+        }
+
+        if (*position == '[')
+        {
+            const char *name = skip_space(position + 1, last);
+            const char *end = name;
+
+            while (end != last && *end != ']')
+            {
+                ++end;
+            }
+
+            if (end == last)
+            {
+                return "missing ']'";
+            }
+
+            while (end != name && (end[-1] == ' ' || end[-1] == '\t'))
+            {
+                --end;
+            }
+
+            section.assign(name, end);
+            return nullptr;
+        }
+
+        const char *key_end = position;
+
+        while (key_end != last && *key_end != '=' && *key_end != ' ' && *key_end != '\t')
+        {
+            ++key_end;
+        }
+
+        if (key_end == position)
+        {
+            return "missing key";
+        }
+
+        std::string key = section.empty() ? std::string() : section + '.';
+        key.append(position, key_end);
+
+        position = skip_space(key_end, last);
+
+        cmd::CommandLine_t &entry = m_entries[key];
+        entry.assign(1, key);
+
+        if (position == last || *position == '#')
+        {
+            return nullptr;
+        }
+
+        if (*position != '=')
+        {
+            return "expected '='";
+        }
+
+        position = skip_space(position + 1, last);
+
+        if (position != last && *position == '[')
+        {
+            position = skip_space(position + 1, last);
+
+            while (position != last && *position != ']' && *position != '#')
+            {
+                position = parse_value(position, last, entry, true);
+
+                if (!position)
+                {
+                    return "missing closing quote";
+                }
+
+                position = skip_space(position, last);
+
+                if (position != last && *position == ',')
+                {
+                    position = skip_space(position + 1, last);
+                }
+            }
+
+            if (position == last || *position == '#')
+            {
+                return "missing ']'";
+            }
+
+            position = skip_space(position + 1, last);
+        }
+        else if (position != last && *position != '#')
+        {
+            position = parse_value(position, last, entry, false);
+
+            if (!position)
+            {
+                return "missing closing quote";
+            }
+
+            position = skip_space(position, last);
+        }
+
+        if (position != last && *position != '#')
+        {
+            return "unexpected characters after value";
+        }
+
+        return nullptr;
+    }
+
+
+    /**
+     * @brief Internal: Parse a single (quoted or bare) value and append it to an entry.
+     *
+     * @param position The first character of the value.
+     * @param last The end of the line.
+     * @param entry The entry command line to append to.
+     * @param in_array Whether the value is an array element (',' and ']' end bare values).
+     *
+     * @return The position after the value or nullptr if a quote isn't closed.
+     */
+    static const char *parse_value(
+            const char *position,
+            const char *last,
+            cmd::CommandLine_t &entry,
+            const bool in_array)
+    {
+        const char quote = *position;
+
+        if (quote == '"' || quote == '\'')
+        {
+            std::string value;
+
+            for (++position; position != last && *position != quote; ++position)
+            {
+                if (quote == '"' && *position == '\\' && position + 1 != last)
+                {
+                    ++position;
+
+                    switch (*position)
+                    {
+                    case 'n': value.push_back('\n'); break;
+                    case 't': value.push_back('\t'); break;
+                    default: value.push_back(*position); break;
+                    }
+                }
+                else
+                {
+                    value.push_back(*position);
+                }
+            }
+
+            if (position == last)
+            {
+                return nullptr;
+            }
+
+            entry.emplace_back(std::move(value));
+            return position + 1;
+        }
+
+        const char *end = position;
+
+        while (end != last && *end != '#' && !(in_array && (*end == ',' || *end == ']')))
+        {
+            ++end;
+        }
+
+        const char *next = end;
+
+        while (end != position && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+        {
+            --end;
+        }
+
+        entry.emplace_back(position, end);
+        return next;
+    }
+
+
+    /// The configuration entries: key -> (key, value, ...)
+    std::unordered_map<std::string, cmd::CommandLine_t> m_entries;
+};
+
+
+} // namespace config
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_CONFIG_H
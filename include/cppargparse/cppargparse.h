@@ -7,9 +7,23 @@
  */
 
 
+#include <cppargparse/argv.h>
+#include <cppargparse/bind.h>
+#include <cppargparse/cache.h>
 #include <cppargparse/cmd.h>
+#include <cppargparse/config.h>
+#include <cppargparse/env.h>
+#include <cppargparse/events.h>
 #include <cppargparse/arguments.h>
 #include <cppargparse/parser.h>
+#include <cppargparse/reload.h>
+#include <cppargparse/response.h>
+#include <cppargparse/result.h>
+#include <cppargparse/schema.h>
+#include <cppargparse/snapshot.h>
+#include <cppargparse/store.h>
+#include <cppargparse/stream.h>
+#include <cppargparse/usage.h>
 #include <cppargparse/errors.h>
 
 #endif // CPPARGPARSE_H
@@ -0,0 +1,345 @@
+#ifndef CPPARGPARSE_DEFERRED_H
+#define CPPARGPARSE_DEFERRED_H
+
+/**
+  @file cppargparse/deferred.h
+  @brief Queueing argument callbacks and dispatching them on a thread pool.
+
+  Opt-in: this header starts threads, so programs including it link with the platform's thread library,
+  e.g. -pthread. parser.h and cppargparse.h don't include it.
+ */
+
+
+#include <string>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/dispatch.h>
+#include <cppargparse/parser.h>
+
+
+namespace cppargparse {
+namespace deferred {
+
+
+/**
+ * @brief Registers arguments with an ArgumentParser and queues their callbacks until dispatch().
+ *
+ * The add_*_with_callback() methods mirror those of ArgumentParser: argument values are converted during
+ * registration, but the callbacks are queued and receive copies. dispatch() runs them on a work-stealing
+ * thread pool, see dispatch::Queue.
+ *
+ * The dispatcher keeps a reference to the parser, which must outlive it.
+ */
+class Dispatcher
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param parser The argument parser to register arguments with.
+     */
+    explicit Dispatcher(parser::ArgumentParser &parser)
+        : m_parser(parser)
+        , m_queue()
+    {
+    }
+
+
+    /**
+     * @brief Let a callback run after another one.
+     *
+     * Callbacks without dependencies run concurrently.
+     *
+     * @param task The handle of the callback.
+     * @param prerequisite The handle of the callback which must finish first. Must have been added before @p task.
+     *
+     * @throws #cppargparse::errors::Error if @p prerequisite has been added after @p task.
+     */
+    void add_dependency(const dispatch::Task_t task, const dispatch::Task_t prerequisite)
+    {
+        m_queue.depend(task, prerequisite);
+    }
+
+
+    /**
+     * @brief Run the queued callbacks.
+     *
+     * Callbacks whose dependencies have finished run concurrently on a work-stealing thread pool; callbacks
+     * depending on a failed one are skipped. The callbacks receive the parser, whose const methods lock its
+     * caches while the callbacks run. After all callbacks have finished, the error of the failed callback
+     * added first is rethrown.
+     *
+     * @param thread_count The number of threads. 0 uses std::thread::hardware_concurrency().
+     */
+    void dispatch(const unsigned int thread_count = 0)
+    {
+        const Sharing sharing(m_parser);
+        m_queue.run_with<parser::ArgumentParser>(m_parser, thread_count);
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Add a flag argument and queue a callback if it has been passed to the command line.
+     *
+     * @tparam Callback void(const ArgumentParser &)
+     *
+     * @param id The argument ID.
+     * @param callback The callback to run when the flag has been passed to the command line.
+     *
+     * @return The callback's task handle, dispatch::none if the flag hasn't been passed.
+     */
+    dispatch::Task_t add_flag_with_callback(const std::string &id,
+                                            Callback callback)
+    {
+        return queue_flag(m_parser.add_arg(id), callback);
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Add a flag argument and queue a callback if it has been passed to the command line.
+     *
+     * @tparam Callback void(const ArgumentParser &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param callback The callback to run when the flag has been passed to the command line.
+     *
+     * @return The callback's task handle, dispatch::none if the flag hasn't been passed.
+     */
+    dispatch::Task_t add_flag_with_callback(const std::string &id, const std::string &id_alt,
+                                            Callback callback)
+    {
+        return queue_flag(m_parser.add_arg(id, id_alt), callback);
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Add a flag argument and queue a callback if it has been passed to the command line.
+     *
+     * @tparam Callback void(const ArgumentParser &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param description The argument description.
+     * @param callback The callback to run when the flag has been passed to the command line.
+     *
+     * @return The callback's task handle, dispatch::none if the flag hasn't been passed.
+     */
+    dispatch::Task_t add_flag_with_callback(const std::string &id, const std::string &id_alt, const std::string &description,
+                                            Callback callback)
+    {
+        return queue_flag(m_parser.add_arg(id, id_alt, description), callback);
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Add the default help argument (-h, --help) and queue a callback if it has been passed to the command line.
+     *
+     * @tparam Callback void(const ArgumentParser &)
+     *
+     * @param callback The callback to run when the flag has been passed to the command line.
+     *
+     * @return The callback's task handle, dispatch::none if the flag hasn't been passed.
+     */
+    dispatch::Task_t add_help_with_callback(Callback callback)
+    {
+        return queue_flag(m_parser.add_help(), callback);
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and queue a callback with its value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param callback The callback to run with the argument's value.
+     *
+     * @return The callback's task handle.
+     * @throws #cppargparse::errors::CommandLineOptionError if the value cannot be converted.
+     */
+    dispatch::Task_t add_arg_with_callback(const std::string &id,
+                                           Callback callback)
+    {
+        return queue_value<T>(m_parser.get_option<T>(m_parser.add_arg(id)), callback);
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and queue a callback with its value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param callback The callback to run with the argument's value.
+     *
+     * @return The callback's task handle.
+     * @throws #cppargparse::errors::CommandLineOptionError if the value cannot be converted.
+     */
+    dispatch::Task_t add_arg_with_callback(const std::string &id, const std::string &id_alt,
+                                           Callback callback)
+    {
+        return queue_value<T>(m_parser.get_option<T>(m_parser.add_arg(id, id_alt)), callback);
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and queue a callback with its value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param description The argument description.
+     * @param callback The callback to run with the argument's value.
+     *
+     * @return The callback's task handle.
+     * @throws #cppargparse::errors::CommandLineOptionError if the value cannot be converted.
+     */
+    dispatch::Task_t add_arg_with_callback(const std::string &id, const std::string &id_alt, const std::string &description,
+                                           Callback callback)
+    {
+        return queue_value<T>(m_parser.get_option<T>(m_parser.add_arg(id, id_alt, description)), callback);
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and queue a callback with its (default) value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param default_value The default value.
+     * @param callback The callback to run with the argument's (default) value.
+     *
+     * @return The callback's task handle.
+     */
+    dispatch::Task_t add_arg_with_callback_default(const std::string &id, const T &default_value,
+                                                   Callback callback)
+    {
+        return queue_value<T>(m_parser.get_option<T>(m_parser.add_arg(id), default_value), callback);
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and queue a callback with its (default) value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param default_value The default value.
+     * @param callback The callback to run with the argument's (default) value.
+     *
+     * @return The callback's task handle.
+     */
+    dispatch::Task_t add_arg_with_callback_default(const std::string &id, const std::string &id_alt, const T &default_value,
+                                                   Callback callback)
+    {
+        return queue_value<T>(m_parser.get_option<T>(m_parser.add_arg(id, id_alt), default_value), callback);
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and queue a callback with its (default) value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param description The argument description.
+     * @param default_value The default value.
+     * @param callback The callback to run with the argument's (default) value.
+     *
+     * @return The callback's task handle.
+     */
+    dispatch::Task_t add_arg_with_callback_default(const std::string &id, const std::string &id_alt,
+                                                   const std::string &description, const T &default_value,
+                                                   Callback callback)
+    {
+        return queue_value<T>(m_parser.get_option<T>(m_parser.add_arg(id, id_alt, description), default_value), callback);
+    }
+
+
+private:
+    /**
+     * @brief Internal: Lets a parser lock its caches while it is in scope.
+     */
+    struct Sharing
+    {
+        explicit Sharing(parser::ArgumentParser &parser)
+            : parser(parser)
+        {
+            parser.m_mutex.shared = true;
+        }
+
+        ~Sharing()
+        {
+            parser.m_mutex.shared = false;
+        }
+
+        /// The shared parser
+        parser::ArgumentParser &parser;
+    };
+
+
+    template <typename Callback>
+    /**
+     * @brief Internal: Queue a flag callback if the flag has been passed.
+     */
+    dispatch::Task_t queue_flag(const cmd::CommandLineArgument &cmdarg, Callback callback)
+    {
+        if (!m_parser.get_flag(cmdarg))
+        {
+            return dispatch::none;
+        }
+
+        return m_queue.push_with_context<parser::ArgumentParser>([callback](const parser::ArgumentParser &parser)
+        {
+            callback(parser);
+        });
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Internal: Queue an argument callback holding a copy of the value.
+     */
+    dispatch::Task_t queue_value(const T &value, Callback callback)
+    {
+        return m_queue.push_with_context<parser::ArgumentParser>([callback, value](const parser::ArgumentParser &parser)
+        {
+            callback(parser, value);
+        });
+    }
+
+
+    /// The argument parser
+    parser::ArgumentParser &m_parser;
+
+    /// The queued callbacks
+    dispatch::Queue m_queue;
+};
+
+
+} // namespace deferred
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_DEFERRED_H
@@ -0,0 +1,556 @@
+#ifndef CPPARGPARSE_DISPATCH_H
+#define CPPARGPARSE_DISPATCH_H
+
+/**
+  @file cppargparse/dispatch.h
+  @brief Running queued callbacks on a work-stealing thread pool.
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cppargparse/errors.h>
+
+
+namespace cppargparse {
+namespace dispatch {
+
+
+/**
+ * @brief A task handle: the index of a queued task.
+ */
+typedef size_t Task_t;
+
+
+/**
+ * @brief The handle of callbacks which haven't been queued, e.g. because they have been run right away.
+ */
+constexpr Task_t none = errors::npos;
+
+
+/**
+ * @brief A queue of tasks with dependencies, run by run().
+ *
+ * Tasks without pending prerequisites run concurrently. A task runs after all of its prerequisites have
+ * finished; if one of them failed, the task is skipped.
+ *
+ * Tasks can take a context, which is passed to run_with(), so they don't need to hold on to an object which
+ * may move before the queue runs. Queues holding tasks can't be copied: the copies would run each task twice.
+ */
+class Queue
+{
+public:
+    /**
+     * @brief c'tor
+     */
+    Queue()
+        : m_nodes()
+    {
+    }
+
+
+    /**
+     * @brief Copy c'tor
+     *
+     * @param other The queue to copy. Must be empty.
+     *
+     * @throws #cppargparse::errors::Error if @p other holds tasks.
+     */
+    Queue(const Queue &other)
+        : m_nodes()
+    {
+        check_empty(other);
+    }
+
+
+    /**
+     * @brief Copy assignment
+     *
+     * @param other The queue to copy. Must be empty.
+     *
+     * @return This queue.
+     * @throws #cppargparse::errors::Error if @p other holds tasks.
+     */
+    Queue &operator=(const Queue &other)
+    {
+        check_empty(other);
+        m_nodes.clear();
+
+        return *this;
+    }
+
+
+    template <typename Callable>
+    /**
+     * @brief Queue a task.
+     *
+     * @tparam Callable void()
+     *
+     * @param callable The task.
+     *
+     * @return The task handle.
+     */
+    Task_t push(Callable callable)
+    {
+        m_nodes.push_back(Node {std::make_shared<Task<Callable>>(std::move(callable)), std::vector<Task_t>(), 0});
+
+        return m_nodes.size() - 1;
+    }
+
+
+    template <typename Context, typename Callable>
+    /**
+     * @brief Queue a task taking the context passed to run_with().
+     *
+     * @tparam Context The context type.
+     * @tparam Callable void(const Context &)
+     *
+     * @param callable The task.
+     *
+     * @return The task handle.
+     */
+    Task_t push_with_context(Callable callable)
+    {
+        m_nodes.push_back(Node {std::make_shared<ContextTask<Context, Callable>>(std::move(callable)), std::vector<Task_t>(), 0});
+
+        return m_nodes.size() - 1;
+    }
+
+
+    /**
+     * @brief Let a task run after another one.
+     *
+     * Prerequisites must have been queued before the task, so dependencies can't form cycles.
+     * #none on either side is ignored: a callback which hasn't been queued has nothing to wait for.
+     *
+     * @param task The task.
+     * @param prerequisite The task which must finish first.
+     *
+     * @throws #cppargparse::errors::Error if @p prerequisite hasn't been queued before @p task.
+     */
+    void depend(const Task_t task, const Task_t prerequisite)
+    {
+        if (task == none || prerequisite == none)
+        {
+            return;
+        }
+
+        if (task >= m_nodes.size() || prerequisite >= task)
+        {
+            errors::raise<errors::Error>("Invalid callback dependency");
+        }
+
+        m_nodes[prerequisite].dependents.push_back(task);
+        ++m_nodes[task].prerequisites;
+    }
+
+
+    /**
+     * @brief Return the number of queued tasks.
+     *
+     * @return The number of queued tasks.
+     */
+    size_t size() const
+    {
+        return m_nodes.size();
+    }
+
+
+    /**
+     * @brief Run all queued tasks and empty the queue.
+     *
+     * Ready tasks are spread over per-thread deques. Each thread runs tasks from the back of its own deque,
+     * where the tasks it unblocks are pushed as well, and steals from the front of the others when it runs dry.
+     * The calling thread is one of the workers. If fewer threads can be started than requested, the started
+     * ones run all tasks.
+     *
+     * Errors are reported deterministically: after all tasks have finished or been skipped, the error of
+     * the failed task queued first is rethrown, whatever order the tasks ran in.
+     *
+     * @param thread_count The number of threads. 0 uses std::thread::hardware_concurrency().
+     */
+    void run(const unsigned int thread_count = 0)
+    {
+        run_erased(nullptr, thread_count);
+    }
+
+
+    template <typename Context>
+    /**
+     * @brief Run all queued tasks with a context and empty the queue, see run().
+     *
+     * @tparam Context The context type. Must be the type the tasks have been queued with.
+     *
+     * @param context The context passed to tasks queued with push_with_context().
+     * @param thread_count The number of threads. 0 uses std::thread::hardware_concurrency().
+     */
+    void run_with(const Context &context, const unsigned int thread_count = 0)
+    {
+        run_erased(&context, thread_count);
+    }
+
+
+private:
+    /**
+     * @brief Internal: Raise an error if a queue holds tasks.
+     */
+    static void check_empty(const Queue &queue)
+    {
+        if (!queue.m_nodes.empty())
+        {
+            errors::raise<errors::Error>("Cannot copy a queue holding tasks");
+        }
+    }
+
+
+    /**
+     * @brief Internal: Run all queued tasks with a type-erased context.
+     */
+    void run_erased(const void *context, unsigned int thread_count)
+    {
+        std::vector<Node> nodes;
+        nodes.swap(m_nodes);
+
+        if (nodes.empty())
+        {
+            return;
+        }
+
+        if (thread_count == 0)
+        {
+            thread_count = std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        Run state(nodes, context, static_cast<size_t>(thread_count));
+        std::vector<std::thread> threads;
+        threads.reserve(state.workers.size() - 1);
+
+#if CPPARGPARSE_EXCEPTIONS
+        try
+        {
+#endif
+            for (size_t worker = 1; worker < state.workers.size(); ++worker)
+            {
+                threads.emplace_back([&state, worker]()
+                {
+                    state.work(worker);
+                });
+            }
+#if CPPARGPARSE_EXCEPTIONS
+        }
+
+        catch (const std::system_error &)
+        {
+            // Out of threads: the threads started so far, joined below, steal the tasks of the missing workers
+        }
+#endif
+
+        state.work(0);
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+#if CPPARGPARSE_EXCEPTIONS
+        for (const auto &error : state.errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+#endif
+    }
+
+
+    /**
+     * @brief Internal: A type-erased task.
+     */
+    struct Callback
+    {
+        virtual ~Callback()
+        {
+        }
+
+        virtual void operator()(const void *context) = 0;
+    };
+
+
+    template <typename Callable>
+    /**
+     * @brief Internal: A task holding a callable.
+     */
+    struct Task : Callback
+    {
+        explicit Task(Callable callable)
+            : callable(std::move(callable))
+        {
+        }
+
+        void operator()(const void *) override
+        {
+            callable();
+        }
+
+        /// The callable
+        Callable callable;
+    };
+
+
+    template <typename Context, typename Callable>
+    /**
+     * @brief Internal: A task holding a callable which takes the context.
+     */
+    struct ContextTask : Callback
+    {
+        explicit ContextTask(Callable callable)
+            : callable(std::move(callable))
+        {
+        }
+
+        void operator()(const void *context) override
+        {
+            callable(*static_cast<const Context *>(context));
+        }
+
+        /// The callable
+        Callable callable;
+    };
+
+
+    /**
+     * @brief Internal: A queued task and its dependencies.
+     */
+    struct Node
+    {
+        /// The task
+        std::shared_ptr<Callback> task;
+
+        /// The tasks waiting for this one
+        std::vector<Task_t> dependents;
+
+        /// The number of tasks this one waits for
+        size_t prerequisites;
+    };
+
+
+    /**
+     * @brief Internal: A worker's deque of ready tasks.
+     */
+    struct Worker
+    {
+        /// Guards tasks
+        std::mutex mutex;
+
+        /// The ready tasks
+        std::deque<Task_t> tasks;
+    };
+
+
+    /**
+     * @brief Internal: The state of one run().
+     */
+    struct Run
+    {
+        Run(const std::vector<Node> &nodes, const void *context, const size_t thread_count)
+            : nodes(nodes)
+            , context(context)
+            , remaining(nodes.size())
+            , failed(nodes.size())
+            , errors(nodes.size())
+            , workers(std::min(thread_count, nodes.size()))
+            , pending(0)
+            , done(0)
+            , idle_mutex()
+            , idle()
+        {
+            size_t next = 0;
+
+            for (size_t task = 0; task < nodes.size(); ++task)
+            {
+                remaining[task].store(nodes[task].prerequisites);
+                failed[task].store(false);
+
+                if (nodes[task].prerequisites == 0)
+                {
+                    workers[next++ % workers.size()].tasks.push_back(task);
+                    ++pending;
+                }
+            }
+        }
+
+
+        /**
+         * @brief Run tasks until all of them have finished.
+         */
+        void work(const size_t worker)
+        {
+            Task_t task;
+
+            while (true)
+            {
+                if (take(worker, task))
+                {
+                    execute(worker, task);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(idle_mutex);
+
+                if (done.load() == nodes.size())
+                {
+                    return;
+                }
+
+                idle.wait(lock, [this]()
+                {
+                    return pending.load() != 0 || done.load() == nodes.size();
+                });
+            }
+        }
+
+
+        /**
+         * @brief Take a task from the back of the own deque or steal one from the front of another.
+         */
+        bool take(const size_t worker, Task_t &task)
+        {
+            for (size_t i = 0; i < workers.size(); ++i)
+            {
+                Worker &victim = workers[(worker + i) % workers.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+
+                if (!victim.tasks.empty())
+                {
+                    if (i == 0)
+                    {
+                        task = victim.tasks.back();
+                        victim.tasks.pop_back();
+                    }
+                    else
+                    {
+                        task = victim.tasks.front();
+                        victim.tasks.pop_front();
+                    }
+
+                    --pending;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+
+        /**
+         * @brief Run a task, unless a prerequisite failed, and release its dependents.
+         */
+        void execute(const size_t worker, const Task_t task)
+        {
+            if (!failed[task].load(std::memory_order_acquire))
+            {
+#if CPPARGPARSE_EXCEPTIONS
+                try
+                {
+                    (*nodes[task].task)(context);
+                }
+
+                catch (...)
+                {
+                    errors[task] = std::current_exception();
+                    failed[task].store(true, std::memory_order_relaxed);
+                }
+#else
+                (*nodes[task].task)(context);
+#endif
+            }
+
+            for (const Task_t dependent : nodes[task].dependents)
+            {
+                if (failed[task].load(std::memory_order_relaxed))
+                {
+                    failed[dependent].store(true, std::memory_order_relaxed);
+                }
+
+                if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    ++pending;
+
+                    {
+                        std::lock_guard<std::mutex> lock(workers[worker].mutex);
+                        workers[worker].tasks.push_back(dependent);
+                    }
+
+                    notify();
+                }
+            }
+
+            if (++done == nodes.size())
+            {
+                notify();
+            }
+        }
+
+
+        /**
+         * @brief Wake up idle workers.
+         */
+        void notify()
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex);
+            idle.notify_all();
+        }
+
+
+        /// The tasks
+        const std::vector<Node> &nodes;
+
+        /// The context passed to the tasks
+        const void *context;
+
+        /// Per task: the number of unfinished prerequisites
+        std::vector<std::atomic<size_t>> remaining;
+
+        /// Per task: whether it or one of its prerequisites failed
+        std::vector<std::atomic<bool>> failed;
+
+        /// Per task: its error
+        std::vector<std::exception_ptr> errors;
+
+        /// The per-thread deques
+        std::vector<Worker> workers;
+
+        /// The number of ready tasks in the deques
+        std::atomic<size_t> pending;
+
+        /// The number of finished or skipped tasks
+        std::atomic<size_t> done;
+
+        /// Guards waiting for work
+        std::mutex idle_mutex;
+
+        /// Signalled when tasks become ready or all are done
+        std::condition_variable idle;
+    };
+
+
+    /// The queued tasks
+    std::vector<Node> m_nodes;
+};
+
+
+} // namespace dispatch
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_DISPATCH_H
@@ -0,0 +1,104 @@
+#ifndef CPPARGPARSE_ENV_H
+#define CPPARGPARSE_ENV_H
+
+/**
+  @file cppargparse/env.h
+  @brief Environment variables as an argument source.
+ */
+
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include <cppargparse/cmd.h>
+
+#if defined(_WIN32)
+#define CPPARGPARSE_ENVIRON _environ
+#else
+extern "C" char **environ;
+#define CPPARGPARSE_ENVIRON environ
+#endif
+
+
+namespace cppargparse {
+namespace env {
+
+
+/**
+ * @brief An index of the process environment.
+ *
+ * The environment block is scanned once, on the first lookup, instead of calling getenv() per variable.
+ * Names and values are views into the environment block, nothing is copied.
+ * Variables changed after the first lookup are only seen after calling reindex().
+ */
+class Environment
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * Creates an environment index which is filled on the first lookup.
+     */
+    Environment()
+        : m_variables()
+        , m_indexed(false)
+    {
+    }
+
+
+    /**
+     * @brief Return the value of an environment variable.
+     *
+     * @param name The variable name.
+     *
+     * @return The variable value or nullptr if the variable isn't set.
+     */
+    const char *find(const std::string &name)
+    {
+        if (!m_indexed)
+        {
+            reindex();
+        }
+
+        const auto it = m_variables.find(cmd::TokenView(name));
+
+        return (it == m_variables.cend()) ? nullptr : it->second;
+    }
+
+
+    /**
+     * @brief Scan the environment block again.
+     */
+    void reindex()
+    {
+        m_variables.clear();
+
+        for (char **variable = CPPARGPARSE_ENVIRON; variable && *variable; ++variable)
+        {
+            const char *separator = std::strchr(*variable, '=');
+
+            if (separator)
+            {
+                m_variables.emplace(cmd::TokenView(*variable, static_cast<size_t>(separator - *variable)), separator + 1);
+            }
+        }
+
+        m_indexed = true;
+    }
+
+
+private:
+    /// The environment variables: name -> value
+    std::unordered_map<cmd::TokenView, const char *, cmd::TokenViewHash> m_variables;
+
+    /// Whether the environment block has been scanned
+    bool m_indexed;
+};
+
+
+} // namespace env
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_ENV_H
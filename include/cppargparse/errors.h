@@ -1,15 +1,67 @@
 #ifndef CPPARGPARSE_ERRORS_H
 #define CPPARGPARSE_ERRORS_H
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <limits>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @brief Defined to 1 if errors are thrown as exceptions, 0 if they are reported to errors::sink().
+ *
+ * Detected from the compiler (-fno-exceptions), can be forced to 0 by defining CPPARGPARSE_NO_EXCEPTIONS.
+ */
+#if !defined(CPPARGPARSE_NO_EXCEPTIONS) && (defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND))
+#define CPPARGPARSE_EXCEPTIONS 1
+#else
+#define CPPARGPARSE_EXCEPTIONS 0
+#endif
 
 
 namespace cppargparse {
 namespace errors {
 
 
+/**
+ * @brief Error codes of the non-throwing API, see result::Result.
+ */
+enum class Code
+{
+    /// No error
+    None = 0,
+
+    /// The argument has not been passed and has no fallback value
+    MissingArgument,
+
+    /// The argument has been passed without a value
+    MissingValue,
+
+    /// The value cannot be converted to the requested type
+    InvalidValue,
+
+    /// The value is outside of the range of the requested type
+    OutOfRange
+};
+
+
+/**
+ * @brief The position of errors not tied to a command line token.
+ */
+constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+
 /**
  * @brief Base error class.
+ *
+ * Conversion errors don't build their message when they are raised: they keep the error code, the
+ * position and an excerpt of the offending token, and format the message into an inline buffer on the
+ * first call to what(). Raising them doesn't allocate, and the message stays valid as long as the error.
  */
 class Error : public std::runtime_error
 {
@@ -21,8 +73,124 @@ public:
      */
     explicit Error(const std::string &message)
         : std::runtime_error(std::string("Error: ") + message)
+        , m_code(Code::None)
+        , m_position(npos)
+        , m_type_name(nullptr)
+        , m_token_size(0)
+        , m_truncated(false)
+        , m_formatted(false)
+    {
+    }
+
+
+    /**
+     * @brief Return the error message.
+     *
+     * Conversion errors format their message on the first call. Like the message of any other
+     * exception, it must not be requested concurrently for the same error object before that.
+     *
+     * @return The error message.
+     */
+    const char *what() const noexcept override
+    {
+        if (!m_type_name)
+        {
+            return std::runtime_error::what();
+        }
+
+        if (!m_formatted)
+        {
+            format();
+        }
+
+        return m_message;
+    }
+
+
+    /**
+     * @brief Return the error code.
+     *
+     * @return The error code, errors::Code::None for errors that aren't conversion errors.
+     */
+    Code code() const
     {
+        return m_code;
     }
+
+
+    /**
+     * @brief Return the command line position of the offending token.
+     *
+     * @return The position or #npos if the error isn't tied to a command line token.
+     */
+    size_t position() const
+    {
+        return m_position;
+    }
+
+
+protected:
+    /**
+     * @brief c'tor for conversion errors.
+     *
+     * @param code The error code.
+     * @param position The command line position of the offending token.
+     * @param type_name The name of the requested type. Must outlive the error, e.g. a string literal.
+     * @param token The offending token. Only an excerpt is copied.
+     * @param token_size The size of @p token.
+     */
+    Error(const Code code, const size_t position, const char *type_name, const char *token, const size_t token_size)
+        : std::runtime_error("")
+        , m_code(code)
+        , m_position(position)
+        , m_type_name(type_name)
+        , m_token_size(token_size < sizeof(m_token) ? token_size : sizeof(m_token))
+        , m_truncated(token_size > sizeof(m_token))
+        , m_formatted(false)
+    {
+        std::memcpy(m_token, token, m_token_size);
+    }
+
+
+private:
+    /**
+     * @brief Internal: Format the message of a conversion error into the message buffer.
+     */
+    void format() const noexcept
+    {
+        const char *what = (m_code == Code::MissingValue) ? "Missing value after" : "Couldn't convert";
+        const char *why = (m_code == Code::OutOfRange) ? ": out of range" : "";
+
+        std::snprintf(m_message, sizeof(m_message), "Error: %s '%.*s%s' to type <%s>%s.",
+                what, static_cast<int>(m_token_size), m_token, m_truncated ? "..." : "", m_type_name, why);
+
+        m_formatted = true;
+    }
+
+
+    /// The error code
+    Code m_code;
+
+    /// The command line position of the offending token
+    size_t m_position;
+
+    /// The name of the requested type, nullptr for errors with a preformatted message
+    const char *m_type_name;
+
+    /// An excerpt of the offending token
+    char m_token[32];
+
+    /// The size of the excerpt
+    size_t m_token_size;
+
+    /// Whether the token is longer than the excerpt
+    bool m_truncated;
+
+    /// Whether m_message holds the formatted message
+    mutable bool m_formatted;
+
+    /// The formatted message
+    mutable char m_message[128];
 };
 
 
@@ -59,9 +227,359 @@ public:
         : Error(message)
     {
     }
+
+
+    /**
+     * @brief c'tor for conversion errors. The message is formatted on the first call to what().
+     *
+     * @param code The error code.
+     * @param position The command line position of the offending token.
+     * @param type_name The name of the requested type. Must outlive the error, e.g. a string literal.
+     * @param token The offending token. Only an excerpt is copied.
+     * @param token_size The size of @p token.
+     */
+    CommandLineOptionError(const Code code, const size_t position, const char *type_name, const char *token, const size_t token_size)
+        : Error(code, position, type_name, token, token_size)
+    {
+    }
+};
+
+
+/**
+ * @brief Error class for malformed quoting in tokenized input.
+ */
+class TokenizerError : public Error
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     */
+    explicit TokenizerError(const std::string &message)
+        : Error(message)
+    {
+    }
+};
+
+
+/**
+ * @brief Error class for response file (@file) errors.
+ */
+class ResponseFileError : public Error
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     */
+    explicit ResponseFileError(const std::string &message)
+        : Error(message)
+    {
+    }
+};
+
+
+/**
+ * @brief Error class for configuration file errors.
+ */
+class ConfigFileError : public Error
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     */
+    explicit ConfigFileError(const std::string &message)
+        : Error(message)
+    {
+    }
+};
+
+
+/**
+ * @brief Error class for errors while reading a token stream.
+ */
+class StreamError : public Error
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     */
+    explicit StreamError(const std::string &message)
+        : Error(message)
+    {
+    }
+};
+
+
+/**
+ * @brief Error class for invalid or mismatching parse result snapshots.
+ */
+class SnapshotError : public Error
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     */
+    explicit SnapshotError(const std::string &message)
+        : Error(message)
+    {
+    }
+};
+
+
+/**
+ * @brief Error class for reading a stored value as a different type than it has been stored as.
+ */
+class TypeMismatchError : public Error
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     */
+    explicit TypeMismatchError(const std::string &message)
+        : Error(message)
+    {
+    }
+};
+
+
+/**
+ * @brief Error class for several option errors reported at once, see parser::ArgumentParser::get_options().
+ */
+class AggregateError : public Error
+{
+public:
+    /**
+     * @brief A failed option.
+     */
+    struct Failure
+    {
+        /// The argument ID
+        std::string id;
+
+        /// The error code
+        Code code;
+
+        /// The command line position of the offending token or #npos
+        size_t position;
+    };
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     * @param failures The failed options.
+     */
+    AggregateError(const std::string &message, const std::vector<Failure> &failures)
+        : Error(message)
+        , m_failures(failures)
+    {
+    }
+
+
+    /**
+     * @brief Return the failed options.
+     *
+     * @return The failed options in the order they have been requested.
+     */
+    const std::vector<Failure> &failures() const
+    {
+        return m_failures;
+    }
+
+
+private:
+    /// The failed options
+    std::vector<Failure> m_failures;
+};
+
+
+/**
+ * @brief Error class for tokens which look like options but match no argument, see
+ *        parser::ArgumentParser::check_unknown_options().
+ */
+class UnknownOptionError : public Error
+{
+public:
+    /**
+     * @brief An unknown option.
+     */
+    struct Unknown
+    {
+        /// The token
+        std::string token;
+
+        /// The command line position of the token
+        size_t position;
+    };
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     * @param unknown The unknown options.
+     */
+    UnknownOptionError(const std::string &message, const std::vector<Unknown> &unknown)
+        : Error(message)
+        , m_unknown(unknown)
+    {
+    }
+
+
+    /**
+     * @brief Return the unknown options.
+     *
+     * @return The unknown options in command line order.
+     */
+    const std::vector<Unknown> &unknown() const
+    {
+        return m_unknown;
+    }
+
+
+private:
+    /// The unknown options
+    std::vector<Unknown> m_unknown;
+};
+
+
+/**
+ * @brief Error class for abbreviated options matching several options, see schema::Schema::find_abbreviation().
+ */
+class AmbiguousOptionError : public Error
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param message The error message.
+     * @param candidates The IDs starting with the abbreviation.
+     */
+    AmbiguousOptionError(const std::string &message, const std::vector<std::string> &candidates)
+        : Error(message)
+        , m_candidates(candidates)
+    {
+    }
+
+
+    /**
+     * @brief Return the IDs starting with the abbreviation.
+     *
+     * @return The IDs, sorted.
+     */
+    const std::vector<std::string> &candidates() const
+    {
+        return m_candidates;
+    }
+
+
+private:
+    /// The IDs starting with the abbreviation
+    std::vector<std::string> m_candidates;
 };
 
 
+/**
+ * @brief Return a short description of an error code.
+ *
+ * @param code The error code.
+ *
+ * @return The description, e.g. "invalid value".
+ */
+inline const char *describe(const Code code)
+{
+    switch (code)
+    {
+    case Code::None:
+        return "no error";
+    case Code::MissingArgument:
+        return "missing argument";
+    case Code::MissingValue:
+        return "missing value";
+    case Code::InvalidValue:
+        return "invalid value";
+    case Code::OutOfRange:
+        return "value out of range";
+    }
+
+    return "unknown error";
+}
+
+
+/**
+ * @brief The error sink type: receives errors when exceptions are disabled.
+ */
+typedef void (*Sink_t)(const std::exception &error);
+
+
+/**
+ * @brief Internal: The default error sink. Prints the error to stderr and aborts.
+ *
+ * @param error The error.
+ */
+inline void default_sink(const std::exception &error)
+{
+    std::fprintf(stderr, "%s\n", error.what());
+    std::abort();
+}
+
+
+/**
+ * @brief Return the error sink used when exceptions are disabled.
+ *
+ * @return The error sink.
+ */
+inline Sink_t &sink()
+{
+    static Sink_t sink = &default_sink;
+    return sink;
+}
+
+
+/**
+ * @brief Set the error sink used when exceptions are disabled.
+ *
+ * The sink must not return, e.g. exit the process or longjmp() out. If it returns, the process is aborted.
+ *
+ * @param error_sink The error sink.
+ */
+inline void set_sink(const Sink_t error_sink)
+{
+    sink() = error_sink ? error_sink : &default_sink;
+}
+
+
+template <typename E, typename... Args>
+/**
+ * @brief Throw an error or, if exceptions are disabled, pass it to the error sink.
+ *
+ * @tparam E The error type.
+ *
+ * @param args The error's constructor arguments, usually the error message.
+ */
+[[noreturn]] inline void raise(Args &&... args)
+{
+#if CPPARGPARSE_EXCEPTIONS
+    throw E(std::forward<Args>(args)...);
+#else
+    sink()(E(std::forward<Args>(args)...));
+    std::abort();
+#endif
+}
+
+
 } // namespace errors
 } // namespace cppargparse
 
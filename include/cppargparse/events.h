@@ -0,0 +1,215 @@
+#ifndef CPPARGPARSE_EVENTS_H
+#define CPPARGPARSE_EVENTS_H
+
+/**
+  @file cppargparse/events.h
+  @brief Streaming a command line as classified token events.
+ */
+
+
+#include <cstring>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/schema.h>
+
+
+namespace cppargparse {
+namespace events {
+
+
+/**
+ * @brief The classification of a command line token.
+ */
+enum class Kind
+{
+    /// A token matching an option ID or alternative ID
+    Option,
+
+    /// A token following an option, up to the next option
+    Value,
+
+    /// A token before the first option or after "--"
+    Positional,
+
+    /// The "--" token: all following tokens are positional
+    EndOfOptions
+};
+
+
+/**
+ * @brief A classified command line token.
+ */
+struct Event
+{
+    /// The token classification
+    Kind kind;
+
+    /// The token or token segment, e.g. "5" for "-t5", a view into the command line
+    cmd::TokenView token;
+
+    /// The token index inside the command line
+    size_t index;
+
+    /// The schema index of the option the token is or belongs to, schema::npos for positional tokens and "--"
+    size_t option;
+};
+
+
+/**
+ * @brief A pull parser returning one event per command line token segment.
+ *
+ * Tokens are split by schema::Schema::split(), so "-vxf" yields three options and "--timeout=5" an
+ * option and a value, all with the same index. Segments are classified the way ArgumentParser reads
+ * tokens: the values of an option run up to the next option. The reader keeps only its position and
+ * the current option, so it never allocates and handles command lines of any length in constant memory.
+ *
+ * Example:
+ * @code
+ * const schema::Schema schema(arg_parser.args());
+ * events::Reader reader(schema, argc - 1, argv + 1);
+ * events::Event event;
+ *
+ * while (reader.next(event))
+ * {
+ *     ...
+ * }
+ * @endcode
+ */
+class Reader
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param schema The option schema. Must outlive the reader.
+     * @param argc The command line argument count.
+     * @param argv The command line argument array. Must outlive the events.
+     */
+    Reader(const schema::Schema &schema, const int argc, const char *const *argv)
+        : m_schema(schema)
+        , m_argv(argv)
+        , m_argc(argc > 0 ? static_cast<size_t>(argc) : 0)
+        , m_index(0)
+        , m_token()
+        , m_offset(schema::npos)
+        , m_option(schema::npos)
+        , m_end_of_options(false)
+    {
+    }
+
+
+    /**
+     * @brief Classify the next token segment.
+     *
+     * @param event Receives the event of the next token segment.
+     *
+     * @return Whether there was a token segment left.
+     */
+    bool next(Event &event)
+    {
+        if (m_offset == schema::npos)
+        {
+            if (m_index == m_argc)
+            {
+                return false;
+            }
+
+            const char *token = m_argv[m_index++];
+            m_token = cmd::TokenView(token, std::strlen(token));
+            m_offset = 0;
+
+            if (m_end_of_options || (m_token.size() == 2 && token[0] == '-' && token[1] == '-'))
+            {
+                event.kind = m_end_of_options ? Kind::Positional : Kind::EndOfOptions;
+                event.token = m_token;
+                event.index = m_index - 1;
+                event.option = schema::npos;
+
+                m_end_of_options = true;
+                m_offset = schema::npos;
+                m_option = schema::npos;
+                return true;
+            }
+        }
+
+        schema::Segment segment;
+        m_offset = m_schema.split(m_token, m_offset, segment);
+
+        event.token = cmd::TokenView(m_token.data() + segment.offset, segment.size);
+        event.index = m_index - 1;
+
+        if (segment.option != schema::npos)
+        {
+            m_option = segment.option;
+            event.kind = Kind::Option;
+        }
+        else
+        {
+            event.kind = (m_option != schema::npos) ? Kind::Value : Kind::Positional;
+        }
+
+        event.option = m_option;
+        return true;
+    }
+
+
+private:
+    /// The option schema
+    const schema::Schema &m_schema;
+
+    /// The command line argument array
+    const char *const *m_argv;
+
+    /// The command line argument count
+    size_t m_argc;
+
+    /// The index of the next token
+    size_t m_index;
+
+    /// The current token
+    cmd::TokenView m_token;
+
+    /// The offset of the next segment of the current token or schema::npos to read the next token
+    size_t m_offset;
+
+    /// The schema index of the current option or schema::npos
+    size_t m_option;
+
+    /// Whether "--" has been read
+    bool m_end_of_options;
+};
+
+
+template <typename Handler>
+/**
+ * @brief Push every command line token segment to a handler, in order.
+ *
+ * @tparam Handler void(const Event &event)
+ *
+ * @param schema The option schema.
+ * @param argc The command line argument count.
+ * @param argv The command line argument array.
+ * @param handler Called once per token segment.
+ *
+ * @return The number of token segments.
+ */
+inline size_t parse(const schema::Schema &schema, const int argc, const char *const *argv, Handler handler)
+{
+    Reader reader(schema, argc, argv);
+    Event event;
+    size_t count = 0;
+
+    while (reader.next(event))
+    {
+        handler(event);
+        ++count;
+    }
+
+    return count;
+}
+
+
+} // namespace events
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_EVENTS_H
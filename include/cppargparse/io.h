@@ -0,0 +1,513 @@
+#ifndef CPPARGPARSE_IO_H
+#define CPPARGPARSE_IO_H
+
+/**
+  @file cppargparse/io.h
+  @brief File access helpers used by the argument sources.
+ */
+
+
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <cppargparse/errors.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CPPARGPARSE_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace cppargparse {
+namespace io {
+
+
+/**
+ * @brief A read-only view of a whole file.
+ *
+ * The file is mapped into memory via mmap() where available, so its bytes are never copied.
+ * On other platforms the file is read into an owned buffer.
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * Opens and maps the file. Use is_open() to check whether that succeeded.
+     *
+     * @param path The file path.
+     */
+    explicit MappedFile(const std::string &path)
+        : m_data(nullptr)
+        , m_size(0)
+        , m_open(false)
+#ifdef CPPARGPARSE_HAS_MMAP
+        , m_mapped(false)
+#endif
+    {
+        open(path);
+    }
+
+
+#ifdef CPPARGPARSE_HAS_MMAP
+    /**
+     * @brief c'tor
+     *
+     * Maps an open file, e.g. a memfd. Use is_open() to check whether that succeeded.
+     *
+     * @param fd The file descriptor. Not closed by the mapping.
+     */
+    explicit MappedFile(const int fd)
+        : m_data(nullptr)
+        , m_size(0)
+        , m_open(false)
+        , m_mapped(false)
+    {
+        map(fd);
+    }
+#endif
+
+
+    /**
+     * @brief d'tor
+     *
+     * Unmap the file.
+     */
+    ~MappedFile()
+    {
+#ifdef CPPARGPARSE_HAS_MMAP
+        if (m_mapped)
+        {
+            ::munmap(const_cast<char *>(m_data), m_size);
+        }
+#endif
+    }
+
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+
+    /**
+     * @brief Return whether the file could be opened.
+     *
+     * @return Whether the file could be opened.
+     */
+    bool is_open() const
+    {
+        return m_open;
+    }
+
+
+    /**
+     * @brief Return the first byte of the file.
+     *
+     * @return The first byte of the file, nullptr for empty files.
+     */
+    const char *data() const
+    {
+        return m_data;
+    }
+
+
+    /**
+     * @brief Return the file size in bytes.
+     *
+     * @return The file size in bytes.
+     */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+
+private:
+    /**
+     * @brief Open and map the file.
+     *
+     * @param path The file path.
+     */
+    void open(const std::string &path)
+    {
+#ifdef CPPARGPARSE_HAS_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+
+        if (fd < 0)
+        {
+            return;
+        }
+
+        map(fd);
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+
+        if (!file)
+        {
+            return;
+        }
+
+        m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        m_data = m_buffer.empty() ? nullptr : m_buffer.data();
+        m_size = m_buffer.size();
+        m_open = true;
+#endif
+    }
+
+
+#ifdef CPPARGPARSE_HAS_MMAP
+    /**
+     * @brief Internal: Map an open file.
+     *
+     * @param fd The file descriptor.
+     */
+    void map(const int fd)
+    {
+        struct stat info;
+
+        if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+        {
+            m_size = static_cast<size_t>(info.st_size);
+            m_open = true;
+
+            if (m_size > 0)
+            {
+                void *address = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+                if (address == MAP_FAILED)
+                {
+                    m_size = 0;
+                    m_open = false;
+                }
+                else
+                {
+                    ::madvise(address, m_size, MADV_SEQUENTIAL);
+
+                    m_data = static_cast<const char *>(address);
+                    m_mapped = true;
+                }
+            }
+        }
+    }
+#endif
+
+
+    /// The first byte of the file.
+    const char *m_data;
+
+    /// The file size in bytes.
+    size_t m_size;
+
+    /// Whether the file could be opened.
+    bool m_open;
+
+#ifdef CPPARGPARSE_HAS_MMAP
+    /// Whether m_data points to a mapping which has to be released.
+    bool m_mapped;
+#else
+    /// The file contents.
+    std::vector<char> m_buffer;
+#endif
+};
+
+
+/**
+ * @brief A file path value.
+ */
+class Path
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param path The file path.
+     */
+    explicit Path(const std::string &path = std::string())
+        : m_path(path)
+    {
+    }
+
+
+    /**
+     * @brief Return the file path.
+     *
+     * @return The file path.
+     */
+    const std::string &str() const
+    {
+        return m_path;
+    }
+
+
+private:
+    /// The file path.
+    std::string m_path;
+};
+
+
+/**
+ * @brief A file path value whose file is read ahead by the kernel.
+ *
+ * Creating the value advises the kernel to read the file ahead (posix_fadvise(WILLNEED)), so it's
+ * likely in the page cache when the application opens it. The kernel reads asynchronously and bounds the
+ * read-ahead itself; the constructor only opens the file and issues the advice, it neither reads the file
+ * nor starts a thread. The file stays open while values for it exist, so status() can check which of its
+ * pages have arrived.
+ *
+ * The advice is issued once per file: values created for a path while another value for it exists, e.g.
+ * when an argument is converted again, share its open file instead of opening and advising it again.
+ */
+class PrefetchedPath : public Path
+{
+public:
+    /**
+     * @brief The prefetch status.
+     */
+    enum class Status
+    {
+        /// The kernel has been advised to read the file ahead, some pages aren't in the page cache yet.
+        Requested,
+
+        /// All pages of the file are in the page cache.
+        Complete,
+
+        /// The file could not be opened, or read-ahead isn't supported on this platform.
+        Failed
+    };
+
+
+    /**
+     * @brief c'tor
+     *
+     * Creates a path without prefetching.
+     */
+    PrefetchedPath()
+        : Path()
+        , m_file()
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param path The file path. The kernel is advised to read the file ahead right away, unless a value
+     *             for the same path exists already.
+     */
+    explicit PrefetchedPath(const std::string &path)
+        : Path(path)
+        , m_file(prefetch(path))
+    {
+    }
+
+
+    /**
+     * @brief Return the prefetch status.
+     *
+     * Checks the page cache residency of the file with mincore(), without blocking or reading the file.
+     *
+     * @return The prefetch status.
+     */
+    Status status() const
+    {
+        if (!m_file)
+        {
+            return Status::Failed;
+        }
+
+        return m_file->resident() ? Status::Complete : Status::Requested;
+    }
+
+
+    /**
+     * @brief Return whether the whole file has been read into the page cache.
+     *
+     * @return Whether the status is Status::Complete.
+     */
+    bool prefetched() const
+    {
+        return status() == Status::Complete;
+    }
+
+
+private:
+    /**
+     * @brief Internal: An open file which has been advised to be read ahead.
+     */
+    class File
+    {
+    public:
+        /**
+         * @brief c'tor
+         *
+         * @param fd The file descriptor. Closed by the d'tor.
+         */
+        explicit File(const int fd)
+            : m_fd(fd)
+        {
+        }
+
+
+        /**
+         * @brief d'tor
+         */
+        ~File()
+        {
+#ifdef CPPARGPARSE_HAS_MMAP
+            ::close(m_fd);
+#endif
+        }
+
+
+        File(const File &) = delete;
+        File &operator=(const File &) = delete;
+
+
+        /**
+         * @brief Return whether all pages of the file are in the page cache.
+         *
+         * Maps the file without touching it and asks mincore() which pages are resident.
+         *
+         * @return Whether all pages are resident. False if that cannot be determined.
+         */
+        bool resident() const
+        {
+#ifdef CPPARGPARSE_HAS_MMAP
+            struct stat info;
+
+            if (::fstat(m_fd, &info) != 0)
+            {
+                return false;
+            }
+
+            const size_t size = static_cast<size_t>(info.st_size);
+
+            if (size == 0)
+            {
+                return true;
+            }
+
+            void *data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, 0);
+
+            if (data == MAP_FAILED)
+            {
+                return false;
+            }
+
+            const size_t page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            std::vector<unsigned char> pages((size + page_size - 1) / page_size);
+
+#if defined(__APPLE__)
+            bool resident = ::mincore(data, size, reinterpret_cast<char *>(pages.data())) == 0;
+#else
+            bool resident = ::mincore(data, size, pages.data()) == 0;
+#endif
+
+            for (size_t page = 0; resident && page < pages.size(); ++page)
+            {
+                resident = (pages[page] & 1) != 0;
+            }
+
+            ::munmap(data, size);
+            return resident;
+#else
+            return false;
+#endif
+        }
+
+
+    private:
+        /// The file descriptor
+        int m_fd;
+    };
+
+
+    /**
+     * @brief Internal: Return the advised file of a path, advising it if no value for the path exists.
+     *
+     * @param path The file path.
+     *
+     * @return The open file, nullptr if the advice could not be given.
+     */
+    static std::shared_ptr<const File> prefetch(const std::string &path)
+    {
+        static std::mutex mutex;
+        static std::unordered_map<std::string, std::weak_ptr<const File>> files;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const File> file = files[path].lock();
+
+        if (file)
+        {
+            return file;
+        }
+
+        // Forget the files no value refers to anymore
+        for (auto entry = files.begin(); entry != files.end();)
+        {
+            entry = entry->second.expired() ? files.erase(entry) : std::next(entry);
+        }
+
+        file = advise(path);
+
+        if (file)
+        {
+            files[path] = file;
+        }
+
+        return file;
+    }
+
+
+    /**
+     * @brief Internal: Open a file and advise the kernel to read it ahead.
+     *
+     * @param path The file path.
+     *
+     * @return The open file, nullptr if the advice could not be given.
+     */
+    static std::shared_ptr<const File> advise(const std::string &path)
+    {
+#if defined(CPPARGPARSE_HAS_MMAP) && defined(POSIX_FADV_WILLNEED)
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<const File> file = std::make_shared<const File>(fd);
+
+        if (::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED) != 0)
+        {
+            return nullptr;
+        }
+
+        return file;
+#else
+        (void)path;
+        return nullptr;
+#endif
+    }
+
+
+    /// The advised file shared by copies of the value, nullptr if prefetching failed
+    std::shared_ptr<const File> m_file;
+};
+
+
+} // namespace io
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_IO_H
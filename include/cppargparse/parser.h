@@ -2,19 +2,48 @@
 #define CPPARGPARSE_PARSER_PARSER_H
 
 #include <algorithm>
-#include <functional>
+#include <initializer_list>
 #include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <cppargparse/arguments.h>
+#include <cppargparse/cache.h>
 #include <cppargparse/cmd.h>
+#include <cppargparse/config.h>
+#include <cppargparse/env.h>
 #include <cppargparse/errors.h>
+#include <cppargparse/response.h>
+#include <cppargparse/result.h>
+#include <cppargparse/store.h>
+#include <cppargparse/stream.h>
+#include <cppargparse/tokenizer.h>
+#include <cppargparse/trie.h>
+#include <cppargparse/usage.h>
 
 
 namespace cppargparse {
+namespace deferred {
+class Dispatcher;
+} // namespace deferred
+
 namespace parser {
 
 
+template <typename T>
+/**
+ * @brief Internal: The parameter type of ArgumentParser::get_options(), one argument per requested type.
+ */
+using Option_t = cmd::CommandLineArgument;
+
+
 /**
  * @brief The argument parser class.
  *
@@ -26,15 +55,63 @@ public:
     /**
      * @brief c'tor
      *
+     * Tokens of the form "@path" are replaced by the contents of the response file at path.
+     *
      * @param argc The command line argument count.
      * @param argv The command line argument array.
      * @param application_description The application description.
+     *
+     * @throws #cppargparse::errors::ResponseFileError if a response file (indirectly) references itself.
+     * @throws #cppargparse::errors::TokenizerError if a response file contains unbalanced quotes.
      */
     explicit ArgumentParser(int argc, char *argv[], const std::string &description)
-        : m_cmd(cmd::CommandLine_t(argv, argv + argc))
+        : m_cmd(algorithm::split_long_values(response::expand(argc, argv)))
+        , m_cmdargs()
+        , m_positionals()
+        , m_description(description)
+        , m_config()
+        , m_environment()
+        , m_env_entries()
+        , m_cache()
+        , m_index()
+        , m_store()
+        , m_usage()
+        , m_abbreviations(false)
+        , m_ids()
+        , m_trie()
+        , m_mutex()
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * Parses one line of shell-like text, e.g. a command read from a console. Quotes and backslash escapes
+     * are honored, see tokenizer::for_each_token(). Unlike in argv, "@path" tokens aren't expanded, so a line
+     * received from elsewhere can't make the parser read files.
+     *
+     * @param line The command line.
+     * @param description The application description.
+     *
+     * @throws #cppargparse::errors::TokenizerError if a quote isn't closed.
+     */
+    ArgumentParser(const cmd::TokenView &line, const std::string &description)
+        : m_cmd(algorithm::split_long_values(tokenizer::split(line)))
         , m_cmdargs()
         , m_positionals()
         , m_description(description)
+        , m_config()
+        , m_environment()
+        , m_env_entries()
+        , m_cache()
+        , m_index()
+        , m_store()
+        , m_usage()
+        , m_abbreviations(false)
+        , m_ids()
+        , m_trie()
+        , m_mutex()
     {
     }
 
@@ -96,11 +173,23 @@ public:
     /**
      * @brief Add an argument to the command line arguments list.
      *
+     * Option values end at the next argument, so cached option values are discarded.
+     *
      * @param cmdarg The command line argument struct object.
      */
     void add_arg(const cmd::CommandLineArgument &cmdarg)
     {
         m_cmdargs.emplace_back(cmdarg);
+        m_index.insert(m_cmdargs, m_cmdargs.size() - 1);
+
+        if (m_abbreviations)
+        {
+            insert_abbreviations(m_cmdargs.size() - 1);
+        }
+
+        m_cache.clear();
+        m_store.clear();
+        m_usage.clear();
     }
 
 
@@ -175,331 +264,1370 @@ public:
 
 
     /**
-     * @brief Return whether the command line contains an argument string.
-     *
-     * @param cmdarg The command line argument.
+     * @brief Return the registered command line arguments.
      *
-     * @return Whether the command line contains an argument string.
+     * @return The registered command line arguments, in order of registration.
      */
-    inline bool get_flag(const cmd::CommandLineArgument &cmdarg)
+    const cmd::CommandLineArguments_t &args() const
     {
-        return algorithm::find_arg_position(m_cmd, cmdarg.id(), cmdarg.id_alt()) != m_cmd.cend();
+        return m_cmdargs;
     }
 
 
-    template <typename T>
     /**
-     * @brief Return the positional argument value of type T.
-     *
-     * @tparam T The argument type. argument::convert() must be implemented for T.
+     * @brief Let lookups accept unique prefixes of long options, e.g. "--verb" for "--verbose".
      *
-     * @param positional The positional command line argument.
+     * The IDs are kept in a radix trie, so resolving an abbreviated token takes time proportional to its length.
+     * Abbreviations are resolved when an argument is looked up; exact IDs always win.
      *
-     * @return The argument value of type T.
-     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     * @param allowed Whether abbreviations are allowed.
      */
-    inline const T get_positional(const cmd::CommandLineArgument &positional)
+    void allow_abbreviations(const bool allowed = true)
     {
-        if (positional.position() == m_cmd.cend())
+        if (allowed == m_abbreviations)
         {
-            const auto positional_it = std::find(m_positionals.cbegin(), m_positionals.cend(), positional);
-            const auto positional_index = std::distance(m_positionals.cbegin(), positional_it);
+            return;
+        }
 
-            std::ostringstream message;
-            message << "Cannot find positional argument #" << positional_index + 1;
+        m_abbreviations = allowed;
+        m_ids.clear();
+        m_trie = trie::Trie();
 
-            throw errors::CommandLineArgumentError(message.str());
+        for (size_t argument = 0; allowed && argument < m_cmdargs.size(); ++argument)
+        {
+            insert_abbreviations(argument);
         }
 
-        return argument<T>::convert(m_cmd, positional.position(), m_cmdargs);
+        m_cache.clear();
+        m_store.clear();
     }
 
 
-    template <typename T>
     /**
-     * @brief Return the argument value of type T.
+     * @brief Find an argument by ID or alternative ID.
      *
-     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     * The lookup uses a hash index and doesn't allocate.
      *
-     * @param cmdarg The command line argument.
+     * @param id The ID, e.g. "--threads".
      *
-     * @return The argument value of type T.
-     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     * @return The argument or nullptr if no argument has this ID.
+     */
+    const cmd::CommandLineArgument *find_arg(const cmd::TokenView &id) const
+    {
+        const size_t argument = m_index.find(m_cmdargs, id);
+
+        return (argument == store::npos) ? nullptr : &m_cmdargs[argument];
+    }
+
+
+    /**
+     * @brief Return the command line tokens which look like options but match no argument.
+     *
+     * Every token is looked up once in the argument index, so the cost is linear in the command line
+     * length, however many arguments have been added. Negative numbers and tokens after "--" are skipped,
+     * see algorithm::is_option_like(). Call it after all arguments have been added.
+     *
+     * @return The unknown options in command line order.
      */
-    inline const T get_option(const cmd::CommandLineArgument &cmdarg)
+    std::vector<errors::UnknownOptionError::Unknown> unknown_options() const
     {
-        if (cmdarg.position() == m_cmd.cend())
+        std::vector<errors::UnknownOptionError::Unknown> unknown;
+        const auto is_known = known_ids();
+
+        for (size_t position = 0; position < m_cmd.size(); ++position)
         {
-            std::ostringstream message;
-            message << "Cannot find argument: " << cmdarg.id();
+            const cmd::TokenView token(m_cmd[position]);
+
+            if (token == cmd::TokenView("--"))
+            {
+                break;
+            }
 
-            throw errors::CommandLineArgumentError(message.str());
+            if (algorithm::is_option_like(token) && m_index.find(m_cmdargs, token) == store::npos &&
+                !algorithm::is_short_bundle(token, is_known) && find_abbreviation(token) == trie::npos)
+            {
+                unknown.push_back(errors::UnknownOptionError::Unknown {m_cmd[position], position});
+            }
         }
 
-        return argument<T>::parse(m_cmd, cmdarg.position(), m_cmdargs);
+        return unknown;
     }
 
 
-    template <typename T>
     /**
-     * @brief Return an argument value.
-     *
-     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     * @brief Strict mode: reject command lines containing unknown options, e.g. typos such as "--theads".
      *
-     * @param cmdarg The command line argument.
-     * @param default_value The default argument value of type T.
+     * Call it after all arguments have been added.
      *
-     * @return The argument value of type T or the default value if the argument cannot be found.
-     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found
+     * @throws #cppargparse::errors::UnknownOptionError listing all unknown options, see unknown_options().
      */
-    inline const T get_option(const cmd::CommandLineArgument &cmdarg, const T &default_value)
+    void check_unknown_options() const
     {
-        try
+        const auto unknown = unknown_options();
+
+        if (unknown.empty())
         {
-            return get_option<T>(cmdarg);
+            return;
         }
 
-        catch (const errors::Error &)
+        std::string message = std::to_string(unknown.size()) + " unknown option(s):";
+
+        for (size_t i = 0; i < unknown.size(); ++i)
         {
-            return default_value;
+            message += (i == 0 ? " '" : ", '") + unknown[i].token + "' at position " + std::to_string(unknown[i].position);
         }
+
+        errors::raise<errors::UnknownOptionError>(message, unknown);
     }
 
 
     /**
-     * @brief Add a flag argument and call a callback when it has been passed to the command line.
+     * @brief Load a configuration file as a fallback source for arguments.
      *
-     * @param id The argument ID.
-     * @param callback The callback to call when the flag has been passed to the command line.
+     * Values passed to the command line take precedence over values in the configuration file,
+     * which take precedence over default values. The file is parsed once, here.
+     *
+     * @param path The configuration file path. See #cppargparse::config::ConfigFile for the syntax.
+     *
+     * @throws #cppargparse::errors::ConfigFileError if the file cannot be read or contains a syntax error.
      */
-    void add_flag_with_callback(const std::string &id,
-                                const std::function<void(const ArgumentParser &)> &callback)
+    void load_config(const std::string &path)
     {
-        auto cmdarg = add_arg(id);
-
-        if (get_flag(cmdarg))
-        {
-            callback(*this);
-        }
+        m_config.load(path);
+        m_cache.clear();
+        m_store.clear();
     }
 
 
     /**
-     * @brief Add a flag argument and call a callback when it has been passed to the command line.
+     * @brief Declare an environment variable as a fallback source for an argument.
      *
-     * @param id The argument ID.
-     * @param id_alt The argument alternative ID.
-     * @param callback The callback to call when the flag has been passed to the command line.
+     * Example: --threads <- APP_THREADS
+     *
+     * The environment is indexed once per parser, on the first call. The variable's value is
+     * converted by argument<T> like any command line value. Values passed to the command line
+     * take precedence over environment variables, which take precedence over the configuration file.
+     *
+     * @param cmdarg The command line argument.
+     * @param name The environment variable name.
      */
-    void add_flag_with_callback(const std::string &id, const std::string &id_alt,
-                                const std::function<void(const ArgumentParser &)> &callback)
+    void add_env_fallback(const cmd::CommandLineArgument &cmdarg, const std::string &name)
     {
-        const auto cmdarg = add_arg(id, id_alt);
+        const char *value = m_environment.find(name);
 
-        if (get_flag(cmdarg))
+        if (value)
         {
-            callback(*this);
+            m_env_entries[cmdarg.id()] = cmd::CommandLine_t {name, value};
+        }
+        else
+        {
+            m_env_entries.erase(cmdarg.id());
         }
+
+        m_cache.clear();
+        m_store.clear();
     }
 
 
     /**
-     * @brief Add a flag argument and call a callback when it has been passed to the command line.
+     * @brief Return the source which supplies an argument's value.
      *
-     * @param id The argument ID.
-     * @param id_alt The argument alternative ID.
-     * @param description The argument description.
-     * @param callback The callback to call when the flag has been passed to the command line.
+     * @param cmdarg The command line argument.
+     *
+     * @return The source of the argument's value, #cppargparse::cmd::Source::Default if no source supplies it.
      */
-    void add_flag_with_callback(const std::string &id, const std::string &id_alt, const std::string &description,
-                                const std::function<void(const ArgumentParser &)> &callback)
+    cmd::Source get_source(const cmd::CommandLineArgument &cmdarg) const
     {
-        const auto cmdarg = add_arg(id, id_alt, description);
+        size_t offset = 0;
 
-        if (get_flag(cmdarg))
+        if (find_bundled(cmdarg, offset) != m_cmd.cend())
         {
-            callback(*this);
+            return cmd::Source::CommandLine;
         }
+
+        return resolve_fallback(cmdarg).source;
     }
 
 
     /**
-     * @brief Add the default help argument (-h, --help) and call a callback when it has been passed to the command line.
+     * @brief Return whether the command line contains an argument string.
      *
-     * @param callback The callback to call when the flag has been passed to the command line.
+     * Short flags may be bundled, e.g. "-vxf" for "-v -x -f": all characters of the token must be known short IDs.
+     * If the command line doesn't contain the flag, the flag may still be enabled by an environment variable or the configuration file.
+     * The result is cached until the argument set changes. Safe to call from callbacks run by deferred::Dispatcher::dispatch().
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return Whether the command line contains an argument string.
      */
-    void add_help_with_callback(const std::function<void(const ArgumentParser &)> &callback)
+    inline bool get_flag(const cmd::CommandLineArgument &cmdarg) const
     {
-        const auto cmdarg = add_help();
+        const auto lock = m_mutex.lock();
+        const bool *cached = m_cache.find<bool, Flag>(cmdarg.id());
 
-        if (get_flag(cmdarg))
+        if (cached)
         {
-            callback(*this);
+            return *cached;
+        }
+
+        size_t offset = 0;
+        const auto position = find_bundled(cmdarg, offset);
+
+        if (position != m_cmd.cend() && is_bundle_rest(*position, offset))
+        {
+            return m_cache.store<bool, Flag>(cmdarg.id(), true);
         }
+
+        const Resolution resolution = resolve_fallback(cmdarg);
+
+        return m_cache.store<bool, Flag>(cmdarg.id(),
+               resolution.source != cmd::Source::Default &&
+               algorithm::is_enabled(*resolution.cmd));
     }
 
 
     template <typename T>
     /**
-     * @brief Add an argument and call a callback with its value when it has been passed to the command line.
+     * @brief Return the positional argument value of type T.
      *
-     * @tparam T The argument value type.
+     * @tparam T The argument type. argument::convert() must be implemented for T.
      *
-     * @param id The argument ID.
-     * @param callback The callback to call with the argument's value when the argument has been passed to the command line.
+     * @param positional The positional command line argument.
+     *
+     * @return The argument value of type T.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
      */
-    void add_arg_with_callback(const std::string &id,
-                               const std::function<void(const ArgumentParser &, const T &)> &callback)
+    inline const T get_positional(const cmd::CommandLineArgument &positional) const
     {
-        callback(*this, get_option<T>(add_arg(id)));
+        if (positional.position() == m_cmd.cend())
+        {
+            const auto positional_it = std::find(m_positionals.cbegin(), m_positionals.cend(), positional);
+            const auto positional_index = std::distance(m_positionals.cbegin(), positional_it);
+
+            std::ostringstream message;
+            message << "Cannot find positional argument #" << positional_index + 1;
+
+            errors::raise<errors::CommandLineArgumentError>(message.str());
+        }
+
+        return argument<T>::convert(m_cmd, positional.position(), m_cmdargs);
     }
 
 
     template <typename T>
     /**
-     * @brief Add an argument and call a callback with its value when it has been passed to the command line.
+     * @brief Return the argument value of type T.
      *
-     * @tparam T The argument value type.
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
      *
-     * @param id The argument ID.
-     * @param id_alt The argument alternative ID.
-     * @param callback The callback to call with the argument's value when the argument has been passed to the command line.
+     * The value is converted on the first call and cached per argument and type; later calls return
+     * the cached value. Safe to call from callbacks run by deferred::Dispatcher::dispatch().
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return A reference to the cached argument value of type T. It is invalidated by add_arg(),
+     *         load_config() and add_env_fallback(), like the one returned by get().
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
      */
-    void add_arg_with_callback(const std::string &id, const std::string &id_alt,
-                               const std::function<void(const ArgumentParser &, const T &)> &callback)
+    inline const T &get_option(const cmd::CommandLineArgument &cmdarg) const
     {
-        callback(*this, get_option<T>(add_arg(id, id_alt)));
+        const T *cached = find_cached<T>(cmdarg);
+
+        if (cached)
+        {
+            return *cached;
+        }
+
+        const Resolution resolution = resolve_or_throw(cmdarg);
+
+        return store_cached<T>(cmdarg, parse_resolved<T>(resolution));
     }
 
 
     template <typename T>
     /**
-     * @brief Add an argument and call a callback with its value when it has been passed to the command line.
+     * @brief Return an argument value.
      *
-     * @tparam T The argument value type.
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
      *
-     * @param id The argument ID.
-     * @param id_alt The argument alternative ID.
-     * @param description The argument description.
-     * @param callback The callback to call with the argument's value when the argument has been passed to the command line.
+     * @param cmdarg The command line argument.
+     * @param default_value The default argument value of type T.
+     *
+     * @return The argument value of type T or the default value if the argument cannot be found or converted.
      */
-    void add_arg_with_callback(const std::string &id, const std::string &id_alt, const std::string &description,
-                                       const std::function<void(const ArgumentParser &, const T &)> &callback)
+    inline const T get_option(const cmd::CommandLineArgument &cmdarg, const T &default_value) const
     {
-        callback(*this, get_option<T>(add_arg(id, id_alt, description)));
+        return get_option_or<T>(cmdarg, default_value);
     }
 
 
     template <typename T>
     /**
-     * @brief Add an argument and call a callback with its (default) value.
+     * @brief Return an argument value without throwing.
      *
-     * @tparam T The argument value type.
+     * @tparam T The argument type. Types whose argument struct provides try_convert() are converted without
+     *           any exception being thrown, others fall back to argument::parse().
      *
-     * @param id The argument ID.
-     * @param default_value The default value.
-     * @param callback The callback to call with the argument's (default) value.
+     * Values are cached like those of get_option(), errors aren't.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The argument value or the error code. The error position refers to the command line,
+     *         it is result::npos for values taken from the environment or a configuration file.
      */
-    void add_arg_with_callback_default(const std::string &id, const T &default_value,
-                                       const std::function<void(const ArgumentParser &, const T &)> &callback)
+    inline result::Result<T> try_get_option(const cmd::CommandLineArgument &cmdarg) const
     {
-        callback(*this, get_option<T>(add_arg(id), default_value));
+        const T *cached = find_cached<T>(cmdarg);
+
+        if (cached)
+        {
+            return result::Result<T>(*cached);
+        }
+
+        const Resolution resolution = resolve(cmdarg);
+
+        if (!resolution.cmd)
+        {
+            return result::Result<T>(errors::Code::MissingArgument, result::npos);
+        }
+
+        const result::Result<T> value = result::try_parse<T>(*resolution.cmd, resolution.position, m_cmdargs);
+
+        if (!value)
+        {
+            return result::Result<T>(value.error(), resolution.error_position(value.position()));
+        }
+
+        return result::Result<T>(store_cached<T>(cmdarg, value.value()));
     }
 
 
     template <typename T>
     /**
-     * @brief Add an argument and call a callback with its (default) value.
+     * @brief Return the value of an argument found by ID.
      *
-     * @tparam T The argument value type.
+     * The value is converted on the first call and kept in a store with one slot per argument, which
+     * remembers the type. The returned reference stays valid until the argument set changes, like the
+     * one returned by get_option().
      *
-     * @param id The argument ID.
-     * @param id_alt The argument alternative ID.
-     * @param default_value The default value.
-     * @param callback The callback to call with the argument's (default) value.
+     * @tparam T The argument type. Must be the same in all calls for the same argument.
+     *
+     * @param id The ID or alternative ID, e.g. "--threads".
+     *
+     * @return The argument value of type T.
+     * @throws #cppargparse::errors::CommandLineArgumentError if no argument has this ID or it cannot be found.
+     * @throws #cppargparse::errors::TypeMismatchError if the value has been read as another type before.
      */
-    void add_arg_with_callback_default(const std::string &id, const std::string &id_alt, const T &default_value,
-                                       const std::function<void(const ArgumentParser &, const T &)> &callback)
+    inline const T &get(const cmd::TokenView &id) const
     {
-        callback(*this, get_option<T>(add_arg(id, id_alt), default_value));
+        const auto lock = m_mutex.lock();
+        const size_t index = m_index.find(m_cmdargs, id);
+
+        if (index == store::npos)
+        {
+            errors::raise<errors::CommandLineArgumentError>("Unknown argument: " + id.str());
+        }
+
+        const T *stored = m_store.find<T>(index);
+
+        if (stored)
+        {
+            return *stored;
+        }
+
+        if (m_store.type(index))
+        {
+            errors::raise<errors::TypeMismatchError>("Argument " + id.str() + " has been read as another type");
+        }
+
+        const Resolution resolution = resolve_or_throw(m_cmdargs[index]);
+
+        return m_store.put<T>(index, m_cmdargs.size(), parse_resolved<T>(resolution));
     }
 
 
     template <typename T>
     /**
-     * @brief Add an argument and call a callback with its (default) value.
+     * @brief Return an argument value or a default value, without throwing.
      *
-     * @tparam T The argument value type.
+     * @tparam T The argument type.
      *
-     * @param id The argument ID.
-     * @param id_alt The argument alternative ID.
-     * @param description The argument description.
-     * @param default_value The default value.
-     * @param callback The callback to call with the argument's (default) value.
+     * @param cmdarg The command line argument.
+     * @param default_value The default argument value of type T.
+     *
+     * Values are cached like those of get_option().
+     *
+     * @return The argument value of type T or the default value if the argument cannot be found or converted.
      */
-    void add_arg_with_callback_default(const std::string &id, const std::string &id_alt,
-                                       const std::string &description, const T &default_value,
-                                       const std::function<void(const ArgumentParser &, const T &)> &callback)
+    inline T get_option_or(const cmd::CommandLineArgument &cmdarg, const T &default_value) const
     {
-        callback(*this, get_option<T>(add_arg(id, id_alt, description), default_value));
+        return try_get_option<T>(cmdarg).value_or(default_value);
     }
 
 
+    template <typename... T>
     /**
-     * @brief Generate and return the usage string.
+     * @brief Return the values of several arguments at once.
      *
-     * @return The generated usage string.
+     * Example:
+     * @code
+     * int threads;
+     * std::string name;
+     *
+     * std::tie(threads, name) = arg_parser.get_options<int, std::string>(threads_arg, name_arg);
+     * @endcode
+     *
+     * Where the values of each argument end is taken from a single pass over the command line,
+     * and each value is converted once. An error doesn't stop the remaining arguments from being
+     * converted: all errors are collected and reported together.
+     *
+     * @tparam T The argument types. Must be default constructible.
+     *
+     * @param cmdargs The command line arguments, one per type.
+     *
+     * @return The argument values.
+     * @throws #cppargparse::errors::AggregateError if any of the arguments cannot be found or converted.
      */
-    const std::string usage() const
+    inline std::tuple<T...> get_options(const Option_t<T> &... cmdargs) const
     {
-        // Find the maximum (argument ID, argument alternative ID) length
-        size_t max_id_length = 0;
-
-        for (const auto &cmdarg : m_cmdargs)
-        {
-            const size_t id_length = cmdarg.id().size() + cmdarg.id_alt().size();
-
-            if (id_length > max_id_length)
-            {
-                max_id_length = id_length;
-            }
-        }
-
-        // Add 3 more spaces
-        max_id_length += 3;
+        Batch batch(*this);
 
+        // Braced initialization converts the arguments in order
+        std::tuple<T...> values {batch.get<T>(cmdargs)...};
 
-        // Generate the usage string
-        std::ostringstream usage_string;
-        usage_string << "Usage: " << m_description << '\n' << '\n';
+        batch.raise_failures();
 
-        for (const auto &cmdarg : m_cmdargs)
-        {
-            usage_string << ' ' << ' ' << cmdarg.id();
+        return values;
+    }
 
-            if (!cmdarg.id_alt().empty())
-            {
-                usage_string << '|' << cmdarg.id_alt();
-            }
 
-            for (size_t i = 0; i < max_id_length; ++i)
-            {
-                usage_string << ' ';
+    template <typename T, typename OutputIt>
+    /**
+     * @brief Write the values of a vector argument to an output iterator.
+     *
+     * Unlike get_option<std::vector<T>>(), no std::vector is built.
+     *
+     * @tparam T The argument value type. argument::convert() must be implemented for T.
+     * @tparam OutputIt The output iterator type.
+     *
+     * @param cmdarg The command line argument.
+     * @param out The output iterator to write the values to.
+     *
+     * @return The number of values written. Never truncated.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     */
+    inline fill_result get_option_into(const cmd::CommandLineArgument &cmdarg, OutputIt out)
+    {
+        const Resolution resolution = resolve_or_throw(cmdarg);
+
+        return argument<std::vector<T>>::parse_into(
+                    *resolution.cmd, resolution.position, m_cmdargs, out, std::numeric_limits<size_t>::max());
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Write the values of a vector argument to a caller-provided buffer.
+     *
+     * @tparam T The argument value type. argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument.
+     * @param buffer The buffer to write the values to.
+     * @param size The number of values @p buffer can take.
+     *
+     * @return The number of values written and whether the command line holds more values than @p size.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     */
+    inline fill_result get_option_into(const cmd::CommandLineArgument &cmdarg, T *buffer, const size_t size)
+    {
+        const Resolution resolution = resolve_or_throw(cmdarg);
+
+        return argument<std::vector<T>>::parse_into(*resolution.cmd, resolution.position, m_cmdargs, buffer, size);
+    }
+
+
+    template <typename T, size_t N>
+    /**
+     * @brief Write the values of a vector argument to a caller-provided array.
+     *
+     * @tparam T The argument value type. argument::convert() must be implemented for T.
+     * @tparam N The array size.
+     *
+     * @param cmdarg The command line argument.
+     * @param buffer The array to write the values to.
+     *
+     * @return The number of values written and whether the command line holds more values than @p N.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     */
+    inline fill_result get_option_into(const cmd::CommandLineArgument &cmdarg, T (&buffer)[N])
+    {
+        return get_option_into<T>(cmdarg, buffer, N);
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Call a callback for each value of a vector argument, streaming the values from a file descriptor if requested.
+     *
+     * If the argument's only value is "-", values are read from @p fd as delimiter-separated tokens
+     * (e.g. find -print0 | tool --files -). Memory use stays bounded by the chunk size,
+     * no matter how many values arrive. Otherwise the argument's values are taken from its source as usual.
+     *
+     * @tparam T The argument value type. argument::convert() must be implemented for T.
+     * @tparam Callback The callback type: void(const T &).
+     *
+     * @param cmdarg The command line argument.
+     * @param callback The callback to call for each value.
+     * @param delimiter The token delimiter for streamed values: '\0' or '\n'.
+     * @param fd The file descriptor to stream the values from.
+     *
+     * @return The number of values passed to @p callback.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     * @throws #cppargparse::errors::CommandLineOptionError if a value cannot be converted to T.
+     * @throws #cppargparse::errors::StreamError if reading from @p fd fails.
+     */
+    size_t stream_option(const cmd::CommandLineArgument &cmdarg, Callback callback,
+                         const char delimiter = '\0', const int fd = 0)
+    {
+        const Resolution resolution = resolve_or_throw(cmdarg);
+        const cmd::CommandLinePositions_t positions =
+                algorithm::get_option_positions(*resolution.cmd, resolution.position, m_cmdargs);
+
+        if (positions.size() == 1 && *positions.front() == "-")
+        {
+            stream::TokenReader reader(fd, delimiter);
+            return stream::for_each_value<T>(reader, callback);
+        }
+
+        for (const auto &position : positions)
+        {
+            callback(argument<T>::convert(*resolution.cmd, position, m_cmdargs));
+        }
+
+        return positions.size();
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Add a flag argument and call a callback when it has been passed to the command line.
+     *
+     * @tparam Callback void(const ArgumentParser &)
+     *
+     * @param id The argument ID.
+     * @param callback The callback to call when the flag has been passed to the command line.
+     */
+    void add_flag_with_callback(const std::string &id,
+                                Callback callback)
+    {
+        if (get_flag(add_arg(id)))
+        {
+            callback(*this);
+        }
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Add a flag argument and call a callback when it has been passed to the command line.
+     *
+     * @tparam Callback void(const ArgumentParser &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param callback The callback to call when the flag has been passed to the command line.
+     */
+    void add_flag_with_callback(const std::string &id, const std::string &id_alt,
+                                Callback callback)
+    {
+        if (get_flag(add_arg(id, id_alt)))
+        {
+            callback(*this);
+        }
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Add a flag argument and call a callback when it has been passed to the command line.
+     *
+     * @tparam Callback void(const ArgumentParser &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param description The argument description.
+     * @param callback The callback to call when the flag has been passed to the command line.
+     */
+    void add_flag_with_callback(const std::string &id, const std::string &id_alt, const std::string &description,
+                                Callback callback)
+    {
+        if (get_flag(add_arg(id, id_alt, description)))
+        {
+            callback(*this);
+        }
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Add the default help argument (-h, --help) and call a callback when it has been passed to the command line.
+     *
+     * @tparam Callback void(const ArgumentParser &)
+     *
+     * @param callback The callback to call when the flag has been passed to the command line.
+     */
+    void add_help_with_callback(Callback callback)
+    {
+        if (get_flag(add_help()))
+        {
+            callback(*this);
+        }
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and call a callback with its value when it has been passed to the command line.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param callback The callback to call with the argument's value when the argument has been passed to the command line.
+     */
+    void add_arg_with_callback(const std::string &id,
+                               Callback callback)
+    {
+        callback(*this, get_option<T>(add_arg(id)));
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and call a callback with its value when it has been passed to the command line.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param callback The callback to call with the argument's value when the argument has been passed to the command line.
+     */
+    void add_arg_with_callback(const std::string &id, const std::string &id_alt,
+                               Callback callback)
+    {
+        callback(*this, get_option<T>(add_arg(id, id_alt)));
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and call a callback with its value when it has been passed to the command line.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param description The argument description.
+     * @param callback The callback to call with the argument's value when the argument has been passed to the command line.
+     */
+    void add_arg_with_callback(const std::string &id, const std::string &id_alt, const std::string &description,
+                               Callback callback)
+    {
+        callback(*this, get_option<T>(add_arg(id, id_alt, description)));
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and call a callback with its (default) value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param default_value The default value.
+     * @param callback The callback to call with the argument's (default) value.
+     */
+    void add_arg_with_callback_default(const std::string &id, const T &default_value,
+                                       Callback callback)
+    {
+        callback(*this, get_option<T>(add_arg(id), default_value));
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and call a callback with its (default) value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param default_value The default value.
+     * @param callback The callback to call with the argument's (default) value.
+     */
+    void add_arg_with_callback_default(const std::string &id, const std::string &id_alt, const T &default_value,
+                                       Callback callback)
+    {
+        callback(*this, get_option<T>(add_arg(id, id_alt), default_value));
+    }
+
+
+    template <typename T, typename Callback>
+    /**
+     * @brief Add an argument and call a callback with its (default) value.
+     *
+     * @tparam T The argument value type.
+     * @tparam Callback void(const ArgumentParser &, const T &)
+     *
+     * @param id The argument ID.
+     * @param id_alt The argument alternative ID.
+     * @param description The argument description.
+     * @param default_value The default value.
+     * @param callback The callback to call with the argument's (default) value.
+     */
+    void add_arg_with_callback_default(const std::string &id, const std::string &id_alt,
+                                       const std::string &description, const T &default_value,
+                                       Callback callback)
+    {
+        callback(*this, get_option<T>(add_arg(id, id_alt, description), default_value));
+    }
+
+
+    /**
+     * @brief Generate and return the usage string.
+     *
+     * The string is cached per width until an argument is added. Safe to call from callbacks run by deferred::Dispatcher::dispatch().
+     *
+     * @param width The line width to wrap descriptions at, 0 to disable wrapping.
+     *
+     * @return The generated usage string.
+     */
+    const std::string &usage(const size_t width = 0) const
+    {
+        const auto lock = m_mutex.lock();
+        auto rendered = m_usage.find(width);
+
+        if (rendered == m_usage.end())
+        {
+            rendered = m_usage.emplace(width, cppargparse::usage::render(m_description, m_cmdargs, width)).first;
+        }
+
+        return rendered->second;
+    }
+
+
+    /**
+     * @brief Write the usage string to a file descriptor, wrapped to the terminal width.
+     *
+     * @param fd The file descriptor. Not closed.
+     *
+     * @return Whether the whole usage string has been written.
+     */
+    bool write_usage(const int fd = 1) const
+    {
+        return cppargparse::usage::write(fd, usage(cppargparse::usage::terminal_width(fd)));
+    }
+
+
+private:
+    friend class deferred::Dispatcher;
+
+
+    /**
+     * @brief The command line holding an argument's value and where the value has been found.
+     */
+    struct Resolution
+    {
+        /// The command line holding the argument, nullptr if no source holds it.
+        const cmd::CommandLine_t *cmd;
+
+        /// The argument position inside cmd.
+        cmd::CommandLinePosition_t position;
+
+        /// The source cmd has been taken from.
+        cmd::Source source;
+
+        /// The command line position of the token holding an attached value, e.g. "-t5", errors::npos otherwise.
+        size_t origin;
+
+        /// The (option, value) command line split off an attached value, cmd points to it.
+        std::shared_ptr<const cmd::CommandLine_t> attached;
+
+        /**
+         * @brief Map the position of an error inside cmd to a command line position.
+         *
+         * @param position The position inside cmd.
+         *
+         * @return The command line position or errors::npos if cmd isn't taken from the command line.
+         */
+        size_t error_position(const size_t position) const
+        {
+            if (origin != errors::npos)
+            {
+                return origin;
+            }
+
+            return (source == cmd::Source::CommandLine) ? position : errors::npos;
+        }
+    };
+
+
+    /**
+     * @brief Internal: Converts the arguments requested from get_options() and collects their errors.
+     */
+    class Batch
+    {
+    public:
+        /**
+         * @brief c'tor
+         *
+         * @param parser The argument parser.
+         */
+        explicit Batch(const ArgumentParser &parser)
+            : m_parser(parser)
+            , m_ends()
+            , m_failures()
+        {
+        }
+
+
+        template <typename T>
+        /**
+         * @brief Convert the value of an argument.
+         *
+         * @tparam T The argument type.
+         *
+         * @param cmdarg The command line argument.
+         *
+         * @return The argument value or a default constructed T if it failed.
+         */
+        T get(const cmd::CommandLineArgument &cmdarg)
+        {
+            const Resolution resolution = m_parser.resolve(cmdarg);
+
+            if (!resolution.cmd)
+            {
+                fail(cmdarg, errors::Code::MissingArgument, errors::npos);
+                return T();
+            }
+
+            const bool on_command_line = (resolution.cmd == &m_parser.m_cmd);
+
+            const result::Result<T> value = result::try_parse<T>(
+                    *resolution.cmd, resolution.position,
+                    on_command_line ? end(resolution.position) : resolution.cmd->cend(),
+                    m_parser.m_cmdargs);
+
+            if (!value)
+            {
+                fail(cmdarg, value.error(), resolution.error_position(value.position()));
+            }
+
+            return value.value();
+        }
+
+
+        /**
+         * @brief Raise the collected errors, if any.
+         *
+         * @throws #cppargparse::errors::AggregateError if any argument failed.
+         */
+        void raise_failures() const
+        {
+            if (m_failures.empty())
+            {
+                return;
+            }
+
+            std::string message = std::to_string(m_failures.size()) + " invalid argument(s): ";
+
+            for (size_t i = 0; i < m_failures.size(); ++i)
+            {
+                const auto &failure = m_failures[i];
+
+                message += (i == 0) ? "" : "; ";
+                message += failure.id + ": " + errors::describe(failure.code);
+
+                if (failure.position != errors::npos)
+                {
+                    message += " '" + m_parser.m_cmd[failure.position] + "'";
+                }
+            }
+
+            errors::raise<errors::AggregateError>(message, m_failures);
+        }
+
+
+    private:
+        /**
+         * @brief Internal: Record a failed argument.
+         */
+        void fail(const cmd::CommandLineArgument &cmdarg, const errors::Code code, const size_t position)
+        {
+            m_failures.push_back(errors::AggregateError::Failure {cmdarg.id(), code, position});
+        }
+
+
+        /**
+         * @brief Internal: Return the position of the next known argument after a command line position.
+         *
+         * The positions are computed for the whole command line on the first call, in one pass.
+         *
+         * @param position The command line position.
+         *
+         * @return The position of the next known argument or the end of the command line.
+         */
+        cmd::CommandLinePosition_t end(const cmd::CommandLinePosition_t &position)
+        {
+            const cmd::CommandLine_t &cmd = m_parser.m_cmd;
+
+            if (m_ends.empty())
+            {
+                std::unordered_set<cmd::TokenView, cmd::TokenViewHash> ids;
+
+                for (const auto &cmdarg : m_parser.m_cmdargs)
+                {
+                    ids.insert(cmd::TokenView(cmdarg.id()));
+
+                    if (!cmdarg.id_alt().empty())
+                    {
+                        ids.insert(cmd::TokenView(cmdarg.id_alt()));
+                    }
+                }
+
+                const auto is_known = [&ids](const cmd::TokenView &id)
+                {
+                    return ids.count(id) != 0;
+                };
+
+                m_ends.resize(cmd.size() + 1, cmd.size());
+
+                for (size_t i = cmd.size(); i-- > 0;)
+                {
+                    const cmd::TokenView token(cmd[i]);
+                    const bool known = is_known(token) || algorithm::is_short_bundle(token, is_known) ||
+                                       m_parser.find_abbreviation(token) != trie::npos;
+
+                    m_ends[i] = known ? i : m_ends[i + 1];
+                }
+            }
+
+            const size_t index = static_cast<size_t>(position - cmd.cbegin());
+
+            return cmd.cbegin() + static_cast<std::ptrdiff_t>(m_ends[index + 1]);
+        }
+
+
+        /// The argument parser
+        const ArgumentParser &m_parser;
+
+        /// Per command line position: the position of the next known argument at or after it
+        std::vector<size_t> m_ends;
+
+        /// The failed arguments
+        std::vector<errors::AggregateError::Failure> m_failures;
+    };
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Return the cached value of an argument.
+     *
+     * @return The value or nullptr if none of type T has been cached.
+     */
+    const T *find_cached(const cmd::CommandLineArgument &cmdarg) const
+    {
+        const auto lock = m_mutex.lock();
+
+        return m_cache.find<T>(cmdarg.id());
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Cache the value of an argument, unless a concurrent callback has cached one in the meantime.
+     *
+     * @return The cached value.
+     */
+    const T &store_cached(const cmd::CommandLineArgument &cmdarg, T value) const
+    {
+        const auto lock = m_mutex.lock();
+        const T *cached = m_cache.find<T>(cmdarg.id());
+
+        return cached ? *cached : m_cache.store<T>(cmdarg.id(), std::move(value));
+    }
+
+
+    /**
+     * @brief Internal: The cache key type of flags, which are cached apart from bool options.
+     */
+    struct Flag
+    {
+    };
+
+
+    /**
+     * @brief Internal: A mutex which is only locked while the parser is shared by concurrent callbacks.
+     *
+     * Parser copies don't share it: copying creates a new, unshared one.
+     */
+    struct Mutex
+    {
+        Mutex()
+            : mutex()
+            , shared(false)
+        {
+        }
+
+        Mutex(const Mutex &)
+            : mutex()
+            , shared(false)
+        {
+        }
+
+        Mutex &operator=(const Mutex &)
+        {
+            return *this;
+        }
+
+        /**
+         * @brief Lock the mutex if the parser is shared.
+         *
+         * @return The lock, which doesn't own the mutex if the parser isn't shared.
+         */
+        std::unique_lock<std::mutex> lock()
+        {
+            return shared ? std::unique_lock<std::mutex>(mutex) : std::unique_lock<std::mutex>();
+        }
+
+        /// The mutex
+        std::mutex mutex;
+
+        /// Whether concurrent callbacks share the parser, set by deferred::Dispatcher::dispatch()
+        bool shared;
+    };
+
+
+    /**
+     * @brief Find the source holding an argument's value.
+     *
+     * Sources are checked in order of precedence: the command line, environment variables, the configuration file.
+     * Fallback sources hold small command lines of the form (name, value, ...).
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The command line holding the argument and the argument position inside it.
+     */
+    Resolution resolve(const cmd::CommandLineArgument &cmdarg) const
+    {
+        if (cmdarg.position() != m_cmd.cend())
+        {
+            return Resolution {&m_cmd, cmdarg.position(), cmd::Source::CommandLine, errors::npos, nullptr};
+        }
+
+        size_t offset = 0;
+        const auto position = find_bundled(cmdarg, offset);
+
+        if (position == m_cmd.cend())
+        {
+            return resolve_fallback(cmdarg);
+        }
+
+        if (offset == position->size())
+        {
+            return Resolution {&m_cmd, position, cmd::Source::CommandLine, errors::npos, nullptr};
+        }
+
+        const std::shared_ptr<const cmd::CommandLine_t> attached =
+                std::make_shared<const cmd::CommandLine_t>(cmd::CommandLine_t {cmdarg.id(), position->substr(offset)});
+
+        return Resolution {attached.get(), attached->cbegin(), cmd::Source::CommandLine,
+                           static_cast<size_t>(position - m_cmd.cbegin()), attached};
+    }
+
+
+    /**
+     * @brief Find the fallback source holding an argument's value: environment variables, then the configuration file.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The entry holding the argument and the argument position inside it.
+     */
+    Resolution resolve_fallback(const cmd::CommandLineArgument &cmdarg) const
+    {
+        const auto env_entry = m_env_entries.find(cmdarg.id());
+
+        if (env_entry != m_env_entries.cend())
+        {
+            return Resolution {&env_entry->second, env_entry->second.cbegin(), cmd::Source::Environment, errors::npos, nullptr};
+        }
+
+        const cmd::CommandLine_t *config_entry = m_config.find(cmdarg);
+
+        if (config_entry)
+        {
+            return Resolution {config_entry, config_entry->cbegin(), cmd::Source::ConfigFile, errors::npos, nullptr};
+        }
+
+        return Resolution {nullptr, m_cmd.cend(), cmd::Source::Default, errors::npos, nullptr};
+    }
+
+
+    /**
+     * @brief Internal: Tells whether an ID belongs to an added argument.
+     */
+    struct KnownId
+    {
+        bool operator()(const cmd::TokenView &id) const
+        {
+            return parser.m_index.find(parser.m_cmdargs, id) != store::npos;
+        }
+
+        /// The argument parser
+        const ArgumentParser &parser;
+    };
+
+
+    /**
+     * @brief Internal: Return a predicate telling whether an ID belongs to an added argument.
+     */
+    KnownId known_ids() const
+    {
+        return KnownId {*this};
+    }
+
+
+    /**
+     * @brief Internal: Find an argument on the command line, also inside bundled short options and attached values.
+     *
+     * @param cmdarg The command line argument.
+     * @param offset Receives the offset of the rest of the token after the argument's ID, see algorithm::find_arg_position().
+     *
+     * @return The command line position of the token holding the argument.
+     */
+    cmd::CommandLinePosition_t find_bundled(const cmd::CommandLineArgument &cmdarg, size_t &offset) const
+    {
+        const auto position = algorithm::find_arg_position(m_cmd, cmdarg.id(), cmdarg.id_alt(), known_ids(), offset);
+
+        return (position != m_cmd.cend() || !m_abbreviations) ? position : find_abbreviated(cmdarg, offset);
+    }
+
+
+    /**
+     * @brief Internal: Find an argument on the command line by a unique prefix of its long ID, e.g. "--verb".
+     *
+     * @param cmdarg The command line argument.
+     * @param offset Receives the size of the token holding the argument.
+     *
+     * @return The command line position of the abbreviated token.
+     * @throws #cppargparse::errors::AmbiguousOptionError if an abbreviation of the argument's ID matches other arguments too.
+     */
+    cmd::CommandLinePosition_t find_abbreviated(const cmd::CommandLineArgument &cmdarg, size_t &offset) const
+    {
+        const size_t argument = m_index.find(m_cmdargs, cmd::TokenView(cmdarg.id()));
+
+        if (argument == store::npos)
+        {
+            return m_cmd.cend();
+        }
+
+        for (auto it = m_cmd.cbegin(); it != m_cmd.cend() && *it != "--"; ++it)
+        {
+            const cmd::TokenView token(*it);
+
+            if (!is_long_prefix(token) || m_index.find(m_cmdargs, token) != store::npos)
+            {
+                continue;
             }
 
-            if (!cmdarg.description().empty())
+            bool found = false;
+            const size_t option = m_trie.find_prefix(m_ids, token, found);
+
+            if (option == argument)
             {
-                usage_string << cmdarg.description();
+                offset = token.size();
+                return it;
             }
 
-            usage_string << '\n';
+            if (found && option == trie::npos &&
+                (starts_with(cmdarg.id(), token) || starts_with(cmdarg.id_alt(), token)))
+            {
+                raise_ambiguous(token);
+            }
         }
 
-        return usage_string.str();
+        return m_cmd.cend();
+    }
+
+
+    /**
+     * @brief Internal: Return the argument a token abbreviates, without throwing.
+     *
+     * @param token The command line token.
+     *
+     * @return The argument index, trie::npos if abbreviations aren't allowed or the token abbreviates no or several arguments.
+     */
+    size_t find_abbreviation(const cmd::TokenView &token) const
+    {
+        if (!m_abbreviations || !is_long_prefix(token))
+        {
+            return trie::npos;
+        }
+
+        bool found = false;
+
+        return m_trie.find_prefix(m_ids, token, found);
+    }
+
+
+    /**
+     * @brief Internal: Add the long IDs of an argument to the abbreviation trie.
+     */
+    void insert_abbreviations(const size_t argument)
+    {
+        for (const std::string *id : {&m_cmdargs[argument].id(), &m_cmdargs[argument].id_alt()})
+        {
+            if (is_long_prefix(cmd::TokenView(*id)))
+            {
+                m_ids += *id;
+                m_trie.insert(m_ids, m_ids.size() - id->size(), id->size(), argument);
+            }
+        }
+    }
+
+
+    /**
+     * @brief Internal: Return whether a token may abbreviate a long ID: "--" followed by at least one character.
+     */
+    static bool is_long_prefix(const cmd::TokenView &token)
+    {
+        return token.size() > 2 && token[0] == '-' && token[1] == '-';
+    }
+
+
+    /**
+     * @brief Internal: Return whether an ID starts with a prefix.
+     */
+    static bool starts_with(const std::string &id, const cmd::TokenView &prefix)
+    {
+        return id.size() >= prefix.size() && id.compare(0, prefix.size(), prefix.data(), prefix.size()) == 0;
+    }
+
+
+    /**
+     * @brief Internal: Raise an error listing the IDs an abbreviation matches.
+     *
+     * @throws #cppargparse::errors::AmbiguousOptionError
+     */
+    void raise_ambiguous(const cmd::TokenView &prefix) const
+    {
+        std::vector<std::string> candidates;
+
+        for (const auto &cmdarg : m_cmdargs)
+        {
+            for (const std::string *id : {&cmdarg.id(), &cmdarg.id_alt()})
+            {
+                if (starts_with(*id, prefix))
+                {
+                    candidates.push_back(*id);
+                }
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+
+        std::string message = "Ambiguous option '" + prefix.str() + "' could be:";
+
+        for (const auto &candidate : candidates)
+        {
+            message += " " + candidate;
+        }
+
+        errors::raise<errors::AmbiguousOptionError>(message, candidates);
+    }
+
+
+    /**
+     * @brief Internal: Return whether the rest of a token only holds known short IDs, e.g. "xf" of "-vxf".
+     *
+     * @param token The command line token.
+     * @param offset The offset of the rest.
+     *
+     * @return Whether all characters from @p offset on are known short IDs.
+     */
+    bool is_bundle_rest(const std::string &token, const size_t offset) const
+    {
+        for (size_t i = offset; i < token.size(); ++i)
+        {
+            const char short_id[] = {'-', token[i]};
+
+            if (m_index.find(m_cmdargs, cmd::TokenView(short_id, 2)) == store::npos)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert the value of a resolved argument.
+     *
+     * Errors of attached values, e.g. "-tX", are reported at the position of the token holding them.
+     *
+     * @throws #cppargparse::errors::CommandLineOptionError if the value cannot be converted.
+     */
+    T parse_resolved(const Resolution &resolution) const
+    {
+        if (resolution.origin == errors::npos)
+        {
+            return argument<T>::parse(*resolution.cmd, resolution.position, m_cmdargs);
+        }
+
+        result::Result<T> value = result::try_parse<T>(*resolution.cmd, resolution.position, m_cmdargs);
+
+        if (!value)
+        {
+            const std::string &token = (*resolution.cmd)[1];
+
+            errors::raise<errors::CommandLineOptionError>(
+                    value.error(), resolution.origin, cppargparse::type_name<T>(), token.data(), token.size());
+        }
+
+        return value.value();
+    }
+
+
+    /**
+     * @brief Find the source holding an argument's value or throw an error if there is none.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The command line holding the argument and the argument position inside it.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     */
+    Resolution resolve_or_throw(const cmd::CommandLineArgument &cmdarg) const
+    {
+        const Resolution resolution = resolve(cmdarg);
+
+        if (!resolution.cmd)
+        {
+            std::ostringstream message;
+            message << "Cannot find argument: " << cmdarg.id();
+
+            errors::raise<errors::CommandLineArgumentError>(message.str());
+        }
+
+        return resolution;
     }
 
 
-private:
     /// The command line
     cmd::CommandLine_t m_cmd;
 
@@ -511,6 +1639,39 @@ private:
 
     /// The application description
     const std::string m_description;
+
+    /// The configuration file used as a fallback source
+    config::ConfigFile m_config;
+
+    /// The environment index
+    env::Environment m_environment;
+
+    /// The environment variable fallback entries: argument ID -> (variable name, value)
+    std::unordered_map<std::string, cmd::CommandLine_t> m_env_entries;
+
+    /// The converted option values and flags
+    mutable cache::Cache m_cache;
+
+    /// The argument index: ID -> index into m_cmdargs
+    store::Index m_index;
+
+    /// The values read through get(), one per argument
+    mutable store::Store m_store;
+
+    /// The cached usage strings, by line width
+    mutable std::map<size_t, std::string> m_usage;
+
+    /// Whether lookups accept unique prefixes of long IDs
+    bool m_abbreviations;
+
+    /// The IDs in the abbreviation trie, back to back
+    std::string m_ids;
+
+    /// The abbreviation trie over m_ids, filled while abbreviations are allowed
+    trie::Trie m_trie;
+
+    /// Guards m_cache, m_store and m_usage while concurrent callbacks share the parser
+    mutable Mutex m_mutex;
 };
 
 
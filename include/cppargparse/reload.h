@@ -0,0 +1,791 @@
+#ifndef CPPARGPARSE_RELOAD_H
+#define CPPARGPARSE_RELOAD_H
+
+/**
+  @file cppargparse/reload.h
+  @brief Reloadable configuration and response files, published as immutable snapshots.
+ */
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <cppargparse/algorithm.h>
+#include <cppargparse/arguments.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/config.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/response.h>
+#include <cppargparse/result.h>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+
+namespace cppargparse {
+namespace reload {
+
+
+/**
+ * @brief The format of a reloadable file.
+ */
+enum class Format
+{
+    /// A configuration file, see config::ConfigFile
+    ConfigFile,
+
+    /// A response file, see response::expand()
+    ResponseFile
+};
+
+
+/**
+ * @brief The maximum number of concurrent Reloadable::Reader guards.
+ */
+constexpr size_t reader_slots = 64;
+
+
+/**
+ * @brief An immutable snapshot of the values parsed from a reloadable file.
+ */
+class State
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param path The file path.
+     * @param format The file format.
+     * @param cmdargs The command line arguments to look up.
+     * @param generation The number of successful reloads before this one.
+     *
+     * @throws #cppargparse::errors::ConfigFileError if a configuration file cannot be read or contains a syntax error.
+     * @throws #cppargparse::errors::ResponseFileError if a response file cannot be read.
+     */
+    State(const std::string &path, const Format format, const cmd::CommandLineArguments_t &cmdargs, const uint64_t generation)
+        : State(format, cmdargs, generation)
+    {
+        if (format == Format::ConfigFile)
+        {
+            m_config.load(path);
+            return;
+        }
+
+        std::vector<std::string> stack;
+
+        if (!response::expand_file(path, m_cmd, stack))
+        {
+            errors::raise<errors::ResponseFileError>("Cannot read response file: " + path);
+        }
+    }
+
+
+    /**
+     * @brief Parse a file into a new state without raising errors, also when exceptions are disabled.
+     *
+     * @param path The file path.
+     * @param format The file format.
+     * @param cmdargs The command line arguments to look up.
+     * @param generation The number of successful reloads before this one.
+     * @param error Receives the error message if the file cannot be read or parsed.
+     *
+     * @return The state or nullptr on errors.
+     */
+    static std::unique_ptr<State> try_create(
+            const std::string &path,
+            const Format format,
+            const cmd::CommandLineArguments_t &cmdargs,
+            const uint64_t generation,
+            std::string &error)
+    {
+        std::unique_ptr<State> state(new State(format, cmdargs, generation));
+
+        if (format == Format::ConfigFile)
+        {
+            return state->m_config.try_load(path, error) ? std::move(state) : nullptr;
+        }
+
+        std::vector<std::string> stack;
+
+        switch (response::try_expand_file(path, state->m_cmd, stack, error))
+        {
+        case response::Expansion::Expanded:
+            return state;
+
+        case response::Expansion::Missing:
+            error = "Cannot read response file: " + path;
+            return nullptr;
+
+        default:
+            return nullptr;
+        }
+    }
+
+
+    /**
+     * @brief Return the number of successful reloads before this snapshot.
+     *
+     * @return The snapshot generation.
+     */
+    uint64_t generation() const
+    {
+        return m_generation;
+    }
+
+
+    /**
+     * @brief Return whether a flag has been set.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return Whether the flag has been set.
+     */
+    bool get_flag(const cmd::CommandLineArgument &cmdarg) const
+    {
+        if (m_format == Format::ResponseFile)
+        {
+            return algorithm::find_arg_position(m_cmd, cmdarg.id(), cmdarg.id_alt()) != m_cmd.cend();
+        }
+
+        const cmd::CommandLine_t *entry = m_config.find(cmdarg);
+
+        return entry && algorithm::is_enabled(*entry);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return the argument value of type T.
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The argument value of type T.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     */
+    const T get_option(const cmd::CommandLineArgument &cmdarg) const
+    {
+        const cmd::CommandLine_t *cmd;
+        cmd::CommandLinePosition_t position;
+
+        if (!find(cmdarg, cmd, position))
+        {
+            std::ostringstream message;
+            message << "Cannot find argument: " << cmdarg.id();
+
+            errors::raise<errors::CommandLineArgumentError>(message.str());
+        }
+
+        return argument<T>::parse(*cmd, position, m_cmdargs);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return an argument value.
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument.
+     * @param default_value The default argument value of type T.
+     *
+     * @return The argument value of type T or the default value if the argument cannot be found or converted.
+     */
+    const T get_option(const cmd::CommandLineArgument &cmdarg, const T &default_value) const
+    {
+        const cmd::CommandLine_t *cmd;
+        cmd::CommandLinePosition_t position;
+
+        if (!find(cmdarg, cmd, position))
+        {
+            return default_value;
+        }
+
+        return result::try_parse<T>(*cmd, position, m_cmdargs).value_or(default_value);
+    }
+
+
+private:
+    /**
+     * @brief Internal: c'tor for an empty state, filled by the public c'tor or try_create().
+     *
+     * @param format The file format.
+     * @param cmdargs The command line arguments to look up.
+     * @param generation The number of successful reloads before this one.
+     */
+    State(const Format format, const cmd::CommandLineArguments_t &cmdargs, const uint64_t generation)
+        : m_format(format)
+        , m_config()
+        , m_cmd()
+        , m_cmdargs(cmdargs)
+        , m_generation(generation)
+    {
+    }
+
+
+    /**
+     * @brief Internal: Find the command line holding an argument.
+     *
+     * @param cmdarg The command line argument.
+     * @param cmd Receives the command line: the response file or the configuration entry.
+     * @param position Receives the argument position inside cmd.
+     *
+     * @return Whether the argument has been found.
+     */
+    bool find(const cmd::CommandLineArgument &cmdarg, const cmd::CommandLine_t *&cmd, cmd::CommandLinePosition_t &position) const
+    {
+        if (m_format == Format::ResponseFile)
+        {
+            cmd = &m_cmd;
+            position = algorithm::find_arg_position(m_cmd, cmdarg.id(), cmdarg.id_alt());
+
+            return position != m_cmd.cend();
+        }
+
+        cmd = m_config.find(cmdarg);
+
+        if (cmd)
+        {
+            position = cmd->cbegin();
+        }
+
+        return cmd != nullptr;
+    }
+
+
+    /// The file format
+    const Format m_format;
+
+    /// The parsed configuration file, for Format::ConfigFile
+    config::ConfigFile m_config;
+
+    /// The expanded response file, for Format::ResponseFile
+    cmd::CommandLine_t m_cmd;
+
+    /// The command line arguments
+    const cmd::CommandLineArguments_t m_cmdargs;
+
+    /// The snapshot generation
+    const uint64_t m_generation;
+};
+
+
+/**
+ * @brief A configuration or response file which is reparsed whenever it changes.
+ *
+ * A watcher thread (inotify on Linux, polling the modification time elsewhere) reparses the file
+ * off the hot path and publishes the result as a new immutable State through an atomic pointer swap.
+ * Readers never lock: read() announces the current epoch in a reader slot, replaced states are
+ * deleted once no reader slot announces an epoch old enough to still see them.
+ *
+ * Example:
+ * @code
+ * reload::Reloadable settings("service.conf", arg_parser.args());
+ * settings.start();
+ *
+ * // Any thread, lock-free
+ * const int rate = settings.get_option<int>(rate_limit, 100);
+ * @endcode
+ */
+class Reloadable
+{
+public:
+    /**
+     * @brief RAII guard keeping a State alive while it is read.
+     */
+    class Reader
+    {
+    public:
+        /**
+         * @brief Move c'tor
+         *
+         * @param other The guard to move from.
+         */
+        Reader(Reader &&other)
+            : m_slot(other.m_slot)
+            , m_state(other.m_state)
+        {
+            other.m_slot = nullptr;
+        }
+
+
+        /**
+         * @brief d'tor
+         *
+         * Releases the reader slot.
+         */
+        ~Reader()
+        {
+            if (m_slot)
+            {
+                m_slot->store(0);
+            }
+        }
+
+
+        /**
+         * @brief Return the guarded state.
+         *
+         * @return The guarded state.
+         */
+        const State &operator*() const
+        {
+            return *m_state;
+        }
+
+
+        /**
+         * @brief Return the guarded state.
+         *
+         * @return The guarded state.
+         */
+        const State *operator->() const
+        {
+            return m_state;
+        }
+
+
+    private:
+        friend class Reloadable;
+
+
+        /**
+         * @brief Internal: c'tor
+         *
+         * @param slot The claimed reader slot.
+         * @param state The guarded state.
+         */
+        Reader(std::atomic<uint64_t> *slot, const State *state)
+            : m_slot(slot)
+            , m_state(state)
+        {
+        }
+
+
+        Reader(const Reader &) = delete;
+        Reader &operator=(const Reader &) = delete;
+
+
+        /// The claimed reader slot, holding the epoch announced by this reader
+        std::atomic<uint64_t> *m_slot;
+
+        /// The guarded state
+        const State *m_state;
+    };
+
+
+    /**
+     * @brief c'tor
+     *
+     * Parses the file once. Call start() to watch it for changes.
+     *
+     * @param path The file path.
+     * @param cmdargs The command line arguments to look up, e.g. ArgumentParser::args().
+     * @param format The file format.
+     * @param interval How often the watcher thread checks whether it should stop or, without inotify, whether the file changed.
+     *
+     * @throws #cppargparse::errors::ConfigFileError if a configuration file cannot be read or contains a syntax error.
+     * @throws #cppargparse::errors::ResponseFileError if a response file cannot be read.
+     */
+    Reloadable(const std::string &path,
+            const cmd::CommandLineArguments_t &cmdargs,
+            const Format format = Format::ConfigFile,
+            const std::chrono::milliseconds interval = std::chrono::milliseconds(100))
+        : m_path(path)
+        , m_cmdargs(cmdargs)
+        , m_format(format)
+        , m_interval(interval)
+        , m_state(new State(path, format, cmdargs, 0))
+        , m_epoch(1)
+        , m_mutex()
+        , m_retired()
+        , m_error()
+        , m_running(false)
+        , m_thread()
+    {
+        for (auto &slot : m_slots)
+        {
+            slot.store(0);
+        }
+    }
+
+
+    /**
+     * @brief d'tor
+     *
+     * Stops the watcher thread. No Reader may outlive the Reloadable.
+     */
+    ~Reloadable()
+    {
+        stop();
+
+        for (const auto &retired : m_retired)
+        {
+            delete retired.second;
+        }
+
+        delete m_state.load();
+    }
+
+
+    /**
+     * @brief Start watching the file in a background thread.
+     *
+     * The watch is set up before start() returns, so no change made afterwards is missed.
+     */
+    void start()
+    {
+        if (m_running.exchange(true))
+        {
+            return;
+        }
+
+        m_thread = std::thread(&Reloadable::watch, this, open_watch(), signature());
+    }
+
+
+    /**
+     * @brief Stop watching the file and wait for the watcher thread to finish.
+     */
+    void stop()
+    {
+        m_running.store(false);
+
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+
+    /**
+     * @brief Reparse the file now and publish the result.
+     *
+     * If the file cannot be parsed, the current state stays published and error() describes the problem.
+     * Errors are never raised, so a broken file doesn't reach the error sink when exceptions are disabled.
+     *
+     * @return Whether a new state has been published.
+     */
+    bool reload()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        std::string error;
+        std::unique_ptr<State> state = State::try_create(m_path, m_format, m_cmdargs, m_state.load()->generation() + 1, error);
+
+        if (!state)
+        {
+            m_error = errors::Error(error).what();
+            return false;
+        }
+
+        publish(state.release());
+        m_error.clear();
+
+        return true;
+    }
+
+
+    /**
+     * @brief Return the error of the last failed reload.
+     *
+     * @return The error message, empty if the last reload succeeded.
+     */
+    std::string error() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_error;
+    }
+
+
+    /**
+     * @brief Return a guard for the current state.
+     *
+     * Lock-free. Keep guards short-lived: a state replaced by a reload is only deleted once all guards
+     * which might see it are gone. Spins if more than #reader_slots guards are alive at the same time.
+     *
+     * @return The guard.
+     */
+    Reader read() const
+    {
+        static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+        for (size_t i = hint; ; ++i)
+        {
+            std::atomic<uint64_t> &slot = m_slots[i % reader_slots];
+            uint64_t idle = 0;
+
+            if (slot.compare_exchange_strong(idle, m_epoch.load()))
+            {
+                hint = i % reader_slots;
+                return Reader(&slot, m_state.load());
+            }
+        }
+    }
+
+
+    /**
+     * @brief Return whether a flag has been set in the current state.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return Whether the flag has been set.
+     */
+    bool get_flag(const cmd::CommandLineArgument &cmdarg) const
+    {
+        return read()->get_flag(cmdarg);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return the argument value of type T from the current state.
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The argument value of type T.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     */
+    const T get_option(const cmd::CommandLineArgument &cmdarg) const
+    {
+        return read()->template get_option<T>(cmdarg);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return an argument value from the current state.
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument.
+     * @param default_value The default argument value of type T.
+     *
+     * @return The argument value of type T or the default value if the argument cannot be found.
+     */
+    const T get_option(const cmd::CommandLineArgument &cmdarg, const T &default_value) const
+    {
+        return read()->template get_option<T>(cmdarg, default_value);
+    }
+
+
+private:
+    Reloadable(const Reloadable &) = delete;
+    Reloadable &operator=(const Reloadable &) = delete;
+
+
+    /**
+     * @brief Internal: Publish a new state and delete the replaced states no reader can see anymore.
+     *
+     * Must be called with m_mutex held.
+     *
+     * @param state The new state.
+     */
+    void publish(const State *state)
+    {
+        const State *replaced = m_state.exchange(state);
+
+        // Readers announcing an epoch up to this one might still see the replaced state
+        m_retired.emplace_back(m_epoch.fetch_add(1), replaced);
+
+        uint64_t oldest = std::numeric_limits<uint64_t>::max();
+
+        for (const auto &slot : m_slots)
+        {
+            const uint64_t epoch = slot.load();
+
+            if (epoch != 0 && epoch < oldest)
+            {
+                oldest = epoch;
+            }
+        }
+
+        auto retired = m_retired.begin();
+
+        while (retired != m_retired.end())
+        {
+            if (retired->first < oldest)
+            {
+                delete retired->second;
+                retired = m_retired.erase(retired);
+            }
+
+            else
+            {
+                ++retired;
+            }
+        }
+    }
+
+
+    /**
+     * @brief Internal: Return a cheap signature of the file, to detect changes without inotify.
+     *
+     * @return The modification time and size of the file, or a pair of zeros if it doesn't exist.
+     */
+    std::pair<int64_t, int64_t> signature() const
+    {
+        struct stat info;
+
+        if (::stat(m_path.c_str(), &info) != 0)
+        {
+            return std::make_pair(int64_t(0), int64_t(0));
+        }
+
+        return std::make_pair(static_cast<int64_t>(info.st_mtime), static_cast<int64_t>(info.st_size));
+    }
+
+
+    /**
+     * @brief Internal: Start watching the file with inotify.
+     *
+     * Watches the file's directory, so that files replaced by a rename (as most editors do) are picked up.
+     *
+     * @return The inotify file descriptor or -1 if inotify is not available.
+     */
+    int open_watch() const
+    {
+#if defined(__linux__)
+        const int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        const std::string directory = response::directory_of(m_path);
+
+        if (fd >= 0 && ::inotify_add_watch(fd, directory.empty() ? "." : directory.c_str(),
+                IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+
+        return fd;
+#else
+        return -1;
+#endif
+    }
+
+
+    /**
+     * @brief Internal: The watcher thread.
+     *
+     * @param fd The inotify file descriptor from open_watch(), closed when the thread stops.
+     * @param last The file signature when watching started, for polling without inotify.
+     */
+    void watch(const int fd, std::pair<int64_t, int64_t> last)
+    {
+#if defined(__linux__)
+        if (fd >= 0)
+        {
+            const std::string directory = response::directory_of(m_path);
+            const std::string name = m_path.substr(directory.empty() ? 0 : directory.size() + 1);
+
+            alignas(struct inotify_event) char buffer[4096];
+
+            while (m_running.load())
+            {
+                struct pollfd events = {fd, POLLIN, 0};
+
+                if (::poll(&events, 1, static_cast<int>(m_interval.count())) <= 0)
+                {
+                    continue;
+                }
+
+                bool changed = false;
+                ssize_t size;
+
+                while ((size = ::read(fd, buffer, sizeof(buffer))) > 0)
+                {
+                    for (const char *position = buffer; position < buffer + size; )
+                    {
+                        const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(position);
+                        changed = changed || (event->len && name == event->name);
+                        position += sizeof(struct inotify_event) + event->len;
+                    }
+                }
+
+                if (changed)
+                {
+                    reload();
+                }
+            }
+
+            ::close(fd);
+            return;
+        }
+#else
+        (void) fd;
+#endif
+
+        while (m_running.load())
+        {
+            std::this_thread::sleep_for(m_interval);
+
+            const std::pair<int64_t, int64_t> current = signature();
+
+            if (current != last)
+            {
+                last = current;
+                reload();
+            }
+        }
+    }
+
+
+    /// The file path
+    const std::string m_path;
+
+    /// The command line arguments
+    const cmd::CommandLineArguments_t m_cmdargs;
+
+    /// The file format
+    const Format m_format;
+
+    /// The watcher interval
+    const std::chrono::milliseconds m_interval;
+
+    /// The published state
+    std::atomic<const State *> m_state;
+
+    /// The global epoch, incremented on every publish
+    std::atomic<uint64_t> m_epoch;
+
+    /// The reader slots: the epoch announced by an active reader, 0 if idle
+    mutable std::atomic<uint64_t> m_slots[reader_slots];
+
+    /// Serializes writers (reload() and the watcher thread)
+    mutable std::mutex m_mutex;
+
+    /// The replaced states not yet deleted, with the epoch they have been replaced in
+    std::vector<std::pair<uint64_t, const State *>> m_retired;
+
+    /// The error of the last failed reload
+    std::string m_error;
+
+    /// Whether the watcher thread should keep running
+    std::atomic<bool> m_running;
+
+    /// The watcher thread
+    std::thread m_thread;
+};
+
+
+} // namespace reload
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_RELOAD_H
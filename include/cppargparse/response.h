@@ -0,0 +1,332 @@
+#ifndef CPPARGPARSE_RESPONSE_H
+#define CPPARGPARSE_RESPONSE_H
+
+/**
+  @file cppargparse/response.h
+  @brief Response file (@file) expansion.
+ */
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/io.h>
+#include <cppargparse/tokenizer.h>
+
+
+namespace cppargparse {
+namespace response {
+
+
+/**
+ * @brief Return whether a token references a response file.
+ *
+ * @param token The command line token.
+ *
+ * @return Whether @p token has the form "@path".
+ */
+inline bool is_response_file(const cmd::TokenView &token)
+{
+    return token.size() > 1 && token[0] == '@';
+}
+
+
+/**
+ * @brief Internal: Return the canonical form of a file path, used for cycle detection.
+ *
+ * @param path The file path.
+ *
+ * @return The canonical file path or @p path if it cannot be resolved.
+ */
+inline std::string canonical_path(const std::string &path)
+{
+#ifdef CPPARGPARSE_HAS_MMAP
+    char *resolved = ::realpath(path.c_str(), nullptr);
+#else
+    char *resolved = ::_fullpath(nullptr, path.c_str(), 0);
+#endif
+
+    if (!resolved)
+    {
+        return path;
+    }
+
+    std::string canonical(resolved);
+    std::free(resolved);
+
+    return canonical;
+}
+
+
+/**
+ * @brief Internal: Return the directory part of a file path.
+ *
+ * @param path The file path.
+ *
+ * @return The directory part of @p path, or an empty string if there is none.
+ */
+inline std::string directory_of(const std::string &path)
+{
+    const size_t separator = path.find_last_of("/\\");
+
+    return (separator == std::string::npos) ? std::string() : path.substr(0, separator);
+}
+
+
+/**
+ * @brief Internal: Return whether a file path is absolute.
+ *
+ * @param path The file path.
+ *
+ * @return Whether @p path is absolute.
+ */
+inline bool is_absolute(const std::string &path)
+{
+    return (!path.empty() && (path[0] == '/' || path[0] == '\\')) || (path.size() > 1 && path[1] == ':');
+}
+
+
+/**
+ * @brief Internal: The outcome of expanding a response file.
+ */
+enum class Expansion
+{
+    /// The file has been expanded.
+    Expanded,
+
+    /// The file cannot be opened.
+    Missing,
+
+    /// The file (indirectly) references itself.
+    SelfReference,
+
+    /// The file contains unbalanced quotes.
+    UnbalancedQuotes
+};
+
+
+inline Expansion try_expand_file(
+        const std::string &path,
+        cmd::CommandLine_t &cmd,
+        std::vector<std::string> &stack,
+        std::string &error);
+
+
+/**
+ * @brief Internal: Append a token to the command line, expanding it if it references a response file.
+ *
+ * Tokens referencing a file which cannot be opened are kept as they are.
+ *
+ * @param token The token.
+ * @param directory The directory relative paths are resolved against.
+ * @param cmd The command line to append to.
+ * @param stack The canonical paths of the response files currently being expanded.
+ * @param error Receives the error message if a referenced file cannot be expanded.
+ *
+ * @return Expansion::Expanded or the error of a referenced file.
+ */
+inline Expansion try_expand_token(
+        const cmd::TokenView &token,
+        const std::string &directory,
+        cmd::CommandLine_t &cmd,
+        std::vector<std::string> &stack,
+        std::string &error)
+{
+    if (is_response_file(token))
+    {
+        std::string path(token.data() + 1, token.size() - 1);
+
+        if (!directory.empty() && !is_absolute(path))
+        {
+            path = directory + '/' + path;
+        }
+
+        const Expansion expansion = try_expand_file(path, cmd, stack, error);
+
+        if (expansion != Expansion::Missing)
+        {
+            return expansion;
+        }
+    }
+
+    cmd.emplace_back(token.data(), token.size());
+    return Expansion::Expanded;
+}
+
+
+/**
+ * @brief Internal: Append the tokens of a response file to the command line, without raising errors.
+ *
+ * The file is mapped into memory and tokenized in place. Nested response files are resolved
+ * relative to the directory of the file referencing them.
+ *
+ * @param path The response file path.
+ * @param cmd The command line to append to.
+ * @param stack The canonical paths of the response files currently being expanded.
+ * @param error Receives the error message if the file cannot be expanded.
+ *
+ * @return The outcome. On errors, the tokens before the error have been appended.
+ */
+inline Expansion try_expand_file(
+        const std::string &path,
+        cmd::CommandLine_t &cmd,
+        std::vector<std::string> &stack,
+        std::string &error)
+{
+    const io::MappedFile file(path);
+
+    if (!file.is_open())
+    {
+        return Expansion::Missing;
+    }
+
+    const std::string canonical = canonical_path(path);
+
+    if (std::find(stack.cbegin(), stack.cend(), canonical) != stack.cend())
+    {
+        error = "Response file references itself: " + path;
+        return Expansion::SelfReference;
+    }
+
+    stack.emplace_back(canonical);
+    const std::string directory = directory_of(canonical);
+
+    std::string scratch;
+    std::string tokenizer_error;
+    Expansion expansion = Expansion::Expanded;
+
+    // Tokens after a failed nested file are skipped, the first error is reported
+    const bool tokenized = tokenizer::try_for_each_token(file.data(), file.data() + file.size(), scratch, [&](const cmd::TokenView &token)
+    {
+        if (expansion == Expansion::Expanded)
+        {
+            expansion = try_expand_token(token, directory, cmd, stack, error);
+        }
+    }, tokenizer_error);
+
+    stack.pop_back();
+
+    if (expansion == Expansion::Expanded && !tokenized)
+    {
+        error = tokenizer_error;
+        expansion = Expansion::UnbalancedQuotes;
+    }
+
+    return expansion;
+}
+
+
+/**
+ * @brief Internal: Raise the error of a failed expansion.
+ *
+ * @param expansion The outcome of the expansion.
+ * @param error The error message.
+ *
+ * @return @p expansion if it isn't an error.
+ * @throws #cppargparse::errors::ResponseFileError if a file (indirectly) references itself.
+ * @throws #cppargparse::errors::TokenizerError if a file contains unbalanced quotes.
+ */
+inline Expansion raise_on_error(const Expansion expansion, const std::string &error)
+{
+    if (expansion == Expansion::SelfReference)
+    {
+        errors::raise<errors::ResponseFileError>(error);
+    }
+
+    if (expansion == Expansion::UnbalancedQuotes)
+    {
+        errors::raise<errors::TokenizerError>(error);
+    }
+
+    return expansion;
+}
+
+
+/**
+ * @brief Internal: Append a token to the command line, expanding it if it references a response file.
+ *
+ * Tokens referencing a file which cannot be opened are kept as they are.
+ *
+ * @param token The token.
+ * @param directory The directory relative paths are resolved against.
+ * @param cmd The command line to append to.
+ * @param stack The canonical paths of the response files currently being expanded.
+ *
+ * @throws #cppargparse::errors::ResponseFileError if a referenced file (indirectly) references itself.
+ * @throws #cppargparse::errors::TokenizerError if a referenced file contains unbalanced quotes.
+ */
+inline void expand_token(
+        const cmd::TokenView &token,
+        const std::string &directory,
+        cmd::CommandLine_t &cmd,
+        std::vector<std::string> &stack)
+{
+    std::string error;
+    raise_on_error(try_expand_token(token, directory, cmd, stack, error), error);
+}
+
+
+/**
+ * @brief Internal: Append the tokens of a response file to the command line.
+ *
+ * @param path The response file path.
+ * @param cmd The command line to append to.
+ * @param stack The canonical paths of the response files currently being expanded.
+ *
+ * @return Whether the file could be opened.
+ * @throws #cppargparse::errors::ResponseFileError if the file (indirectly) references itself.
+ * @throws #cppargparse::errors::TokenizerError if the file contains unbalanced quotes.
+ */
+inline bool expand_file(const std::string &path, cmd::CommandLine_t &cmd, std::vector<std::string> &stack)
+{
+    std::string error;
+    return raise_on_error(try_expand_file(path, cmd, stack, error), error) == Expansion::Expanded;
+}
+
+
+/**
+ * @brief Build the command line from argc/argv, expanding response files in place.
+ *
+ * Every "@path" token is replaced by the tokens read from the file at path.
+ * Relative paths in argv are resolved against the current working directory.
+ *
+ * @param argc The command line argument count.
+ * @param argv The command line argument array.
+ *
+ * @return The expanded command line.
+ * @throws #cppargparse::errors::ResponseFileError if a response file (indirectly) references itself.
+ * @throws #cppargparse::errors::TokenizerError if a response file contains unbalanced quotes.
+ */
+inline cmd::CommandLine_t expand(int argc, char *argv[])
+{
+    const bool has_response_file = std::any_of(argv, argv + argc, [](const char *token)
+    {
+        return token[0] == '@' && token[1] != '\0';
+    });
+
+    if (!has_response_file)
+    {
+        return cmd::CommandLine_t(argv, argv + argc);
+    }
+
+    cmd::CommandLine_t cmd;
+    std::vector<std::string> stack;
+
+    for (int i = 0; i < argc; ++i)
+    {
+        expand_token(cmd::TokenView(argv[i], std::strlen(argv[i])), std::string(), cmd, stack);
+    }
+
+    return cmd;
+}
+
+
+} // namespace response
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_RESPONSE_H
@@ -0,0 +1,356 @@
+#ifndef CPPARGPARSE_RESULT_H
+#define CPPARGPARSE_RESULT_H
+
+/**
+  @file cppargparse/result.h
+  @brief Non-throwing conversion results (expected-like).
+ */
+
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cppargparse/algorithm.h>
+#include <cppargparse/arguments.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+
+
+namespace cppargparse {
+namespace result {
+
+
+/**
+ * @brief The position of errors not tied to a command line token.
+ */
+constexpr size_t npos = errors::npos;
+
+
+template <typename T>
+/**
+ * @brief Either a value or an error code with the command line position of the offending token.
+ *
+ * @tparam T The value type. Must have a default constructor.
+ */
+class Result
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param value The value.
+     */
+    Result(const T &value)
+        : m_value(value)
+        , m_code(errors::Code::None)
+        , m_position(npos)
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param code The error code.
+     * @param position The command line position of the offending token, npos if there is none.
+     */
+    Result(const errors::Code code, const size_t position)
+        : m_value()
+        , m_code(code)
+        , m_position(position)
+    {
+    }
+
+
+    /**
+     * @brief Return whether the result holds a value.
+     *
+     * @return Whether the result holds a value.
+     */
+    bool ok() const
+    {
+        return m_code == errors::Code::None;
+    }
+
+
+    /**
+     * @brief Return whether the result holds a value.
+     *
+     * @return Whether the result holds a value.
+     */
+    explicit operator bool() const
+    {
+        return ok();
+    }
+
+
+    /**
+     * @brief Return the error code.
+     *
+     * @return The error code, errors::Code::None if the result holds a value.
+     */
+    errors::Code error() const
+    {
+        return m_code;
+    }
+
+
+    /**
+     * @brief Return the command line position of the offending token.
+     *
+     * The position is an index into the command line after response file expansion, which equals the
+     * argv index if no response files are used.
+     *
+     * @return The position or npos if the error isn't tied to a command line token.
+     */
+    size_t position() const
+    {
+        return m_position;
+    }
+
+
+    /**
+     * @brief Return the value.
+     *
+     * @return The value, a default constructed T if the result holds an error.
+     */
+    const T &value() const
+    {
+        return m_value;
+    }
+
+
+    /**
+     * @brief Return the value or a default value.
+     *
+     * @param default_value The default value.
+     *
+     * @return The value or @p default_value if the result holds an error.
+     */
+    T value_or(const T &default_value) const
+    {
+        return ok() ? m_value : default_value;
+    }
+
+
+private:
+    /// The value
+    T m_value;
+
+    /// The error code
+    errors::Code m_code;
+
+    /// The command line position of the offending token
+    size_t m_position;
+};
+
+
+template <typename T>
+/**
+ * @brief Whether argument<T> provides a non-throwing try_convert(first, last, value).
+ */
+struct has_try_convert
+{
+private:
+    template <typename U>
+    static auto check(int) -> decltype(
+            argument<U>::try_convert(static_cast<const char *>(nullptr), static_cast<const char *>(nullptr), std::declval<U &>()),
+            std::true_type());
+
+    template <typename U>
+    static std::false_type check(...);
+
+public:
+    static constexpr bool value = decltype(check<T>(0))::value;
+};
+
+
+template <typename T, typename Enable = void>
+/**
+ * @brief Internal: Non-throwing parsing for types without try_convert().
+ *
+ * Falls back to argument<T>::parse(). With exceptions enabled its errors are caught, without
+ * exceptions they go to the error sink.
+ */
+struct try_argument
+{
+    static Result<T> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+#if CPPARGPARSE_EXCEPTIONS
+        try
+        {
+            return Result<T>(argument<T>::parse(cmd, position, cmdargs));
+        }
+
+        catch (const errors::Error &error)
+        {
+            if (error.code() != errors::Code::None)
+            {
+                return Result<T>(error.code(), error.position());
+            }
+
+            return Result<T>(errors::Code::InvalidValue, npos);
+        }
+#else
+        return Result<T>(argument<T>::parse(cmd, position, cmdargs));
+#endif
+    }
+
+
+    static Result<T> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLinePosition_t &,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return parse(cmd, position, cmdargs);
+    }
+};
+
+
+template <typename T>
+/**
+ * @brief Internal: Non-throwing parsing for types with try_convert().
+ */
+struct try_argument<T, typename std::enable_if<has_try_convert<T>::value>::type>
+{
+    static Result<T> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &)
+    {
+        const auto value_position = std::next(position);
+
+        if (value_position == cmd.cend())
+        {
+            return Result<T>(errors::Code::MissingValue, static_cast<size_t>(position - cmd.cbegin()));
+        }
+
+        T value;
+        const errors::Code code = argument<T>::try_convert(
+                value_position->data(), value_position->data() + value_position->size(), value);
+
+        if (code != errors::Code::None)
+        {
+            return Result<T>(code, static_cast<size_t>(value_position - cmd.cbegin()));
+        }
+
+        return Result<T>(value);
+    }
+
+
+    static Result<T> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLinePosition_t &,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return parse(cmd, position, cmdargs);
+    }
+};
+
+
+template <typename T>
+/**
+ * @brief Internal: Non-throwing parsing for vectors of types with try_convert().
+ */
+struct try_argument<std::vector<T>, typename std::enable_if<has_try_convert<T>::value>::type>
+{
+    static Result<std::vector<T>> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        auto last = std::next(position);
+
+        while (last != cmd.cend() && !algorithm::is_arg_token(cmdargs, *last))
+        {
+            ++last;
+        }
+
+        return parse(cmd, position, last, cmdargs);
+    }
+
+
+    static Result<std::vector<T>> parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLinePosition_t &last,
+            const cmd::CommandLineArguments_t &)
+    {
+        std::vector<T> values;
+        values.reserve(static_cast<size_t>(last - position - 1));
+
+        for (auto current = std::next(position); current != last; ++current)
+        {
+            T value;
+            const errors::Code code = argument<T>::try_convert(current->data(), current->data() + current->size(), value);
+
+            if (code != errors::Code::None)
+            {
+                return Result<std::vector<T>>(code, static_cast<size_t>(current - cmd.cbegin()));
+            }
+
+            values.emplace_back(std::move(value));
+        }
+
+        return Result<std::vector<T>>(values);
+    }
+};
+
+
+template <typename T>
+/**
+ * @brief Parse the values following an argument without throwing, if the end of its values is already known.
+ *
+ * Vectors of types with try_convert() take the values up to @p last without looking them up in @p cmdargs,
+ * other types ignore @p last.
+ *
+ * @tparam T The argument type.
+ *
+ * @param cmd The command line.
+ * @param position The command line argument iterator.
+ * @param last The position of the next known argument or the end of @p cmd.
+ * @param cmdargs The command line arguments.
+ *
+ * @return The value or the error code and the position of the offending token inside @p cmd.
+ */
+inline Result<T> try_parse(
+        const cmd::CommandLine_t &cmd,
+        const cmd::CommandLinePosition_t &position,
+        const cmd::CommandLinePosition_t &last,
+        const cmd::CommandLineArguments_t &cmdargs)
+{
+    return try_argument<T>::parse(cmd, position, last, cmdargs);
+}
+
+
+template <typename T>
+/**
+ * @brief Parse the value following an argument without throwing.
+ *
+ * @tparam T The argument type. Converters providing try_convert() never throw, others fall back to argument::parse().
+ *
+ * @param cmd The command line.
+ * @param position The command line argument iterator.
+ * @param cmdargs The command line arguments.
+ *
+ * @return The value or the error code and the position of the offending token inside @p cmd.
+ */
+inline Result<T> try_parse(
+        const cmd::CommandLine_t &cmd,
+        const cmd::CommandLinePosition_t &position,
+        const cmd::CommandLineArguments_t &cmdargs)
+{
+    return try_argument<T>::parse(cmd, position, cmdargs);
+}
+
+
+} // namespace result
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_RESULT_H
@@ -0,0 +1,971 @@
+#ifndef CPPARGPARSE_SCHEMA_H
+#define CPPARGPARSE_SCHEMA_H
+
+/**
+  @file cppargparse/schema.h
+  @brief Parsing raw command line buffers against a precompiled option schema.
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cppargparse/argument/argument.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/result.h>
+#include <cppargparse/tokenizer.h>
+#include <cppargparse/trie.h>
+
+
+namespace cppargparse {
+namespace schema {
+
+
+/**
+ * @brief Index value for "no option" / "no token".
+ */
+constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+
+/**
+ * @brief A part of a command line token: an option or a value.
+ */
+struct Segment
+{
+    /// The offset of the segment inside the token
+    size_t offset;
+
+    /// The segment size
+    size_t size;
+
+    /// The option index or #npos for values
+    size_t option;
+};
+
+
+/**
+ * @brief A set of options compiled once into a hash index.
+ *
+ * All IDs live in one character buffer, indexed by a flat open addressing table of offsets, so a lookup
+ * reads two contiguous arrays and nothing else. Lookups are read-only, so one schema can be shared by any
+ * number of threads; Builder creates schemas which can't be changed anymore.
+ */
+class Schema
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * Creates an empty schema.
+     */
+    Schema()
+        : m_ids()
+        , m_slots()
+        , m_count(0)
+        , m_size(0)
+        , m_takes_value()
+        , m_abbreviations(false)
+        , m_trie_once()
+        , m_trie()
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param cmdargs The command line arguments to compile. Positional arguments (without ID) are skipped.
+     */
+    explicit Schema(const cmd::CommandLineArguments_t &cmdargs)
+        : Schema()
+    {
+        for (const auto &cmdarg : cmdargs)
+        {
+            if (!cmdarg.id().empty())
+            {
+                add(cmdarg.id(), cmdarg.id_alt());
+            }
+        }
+    }
+
+
+    Schema(const Schema &) = delete;
+    Schema &operator=(const Schema &) = delete;
+
+
+    /**
+     * @brief Add an option.
+     *
+     * @param id The option ID.
+     * @param id_alt The alternative option ID.
+     * @param takes_value Whether the option takes a value, so split() treats the rest of a bundled token
+     *        after it as its value.
+     *
+     * @return The option index, used to access the option's values in a Result.
+     */
+    size_t add(const std::string &id, const std::string &id_alt = std::string(), const bool takes_value = false)
+    {
+        const size_t option = m_size++;
+        m_takes_value.push_back(takes_value);
+
+        insert(id, option);
+
+        if (!id_alt.empty())
+        {
+            insert(id_alt, option);
+        }
+
+        return option;
+    }
+
+
+    /**
+     * @brief Return the option index for a token.
+     *
+     * @param token The command line token.
+     *
+     * @return The index of the option whose ID or alternative ID equals @p token, or #npos.
+     */
+    size_t find(const cmd::TokenView &token) const
+    {
+        return m_slots.empty() ? npos : m_slots[lookup(token)].option;
+    }
+
+
+    /**
+     * @brief Let split() accept unique prefixes of long options, e.g. "--verb" for "--verbose".
+     *
+     * @param allowed Whether abbreviations are allowed.
+     */
+    void allow_abbreviations(const bool allowed = true)
+    {
+        m_abbreviations = allowed;
+    }
+
+
+    /**
+     * @brief Return the option whose IDs are the only ones starting with a prefix.
+     *
+     * The lookup walks a radix trie over all IDs, which is built on the first call.
+     * Strings of a single option (e.g. "--time" for "--timeout" and "--timeout-ms") are unique.
+     * Options added after the first call aren't found, so add all options first.
+     *
+     * @param prefix The prefix, e.g. "--verb".
+     *
+     * @return The option index or #npos if no ID starts with @p prefix.
+     * @throws #cppargparse::errors::AmbiguousOptionError if IDs of several options start with @p prefix.
+     */
+    size_t find_abbreviation(const cmd::TokenView &prefix) const
+    {
+        std::call_once(m_trie_once, [this]()
+        {
+            for (const Slot &slot : m_slots)
+            {
+                if (slot.option != npos)
+                {
+                    m_trie.insert(m_ids, slot.offset, slot.size, slot.option);
+                }
+            }
+        });
+
+        bool found = false;
+        const size_t option = m_trie.find_prefix(m_ids, prefix, found);
+
+        if (found && option == npos)
+        {
+            std::vector<std::string> candidates;
+
+            for (const Slot &slot : m_slots)
+            {
+                if (slot.option != npos && slot.size >= prefix.size() && std::memcmp(m_ids.data() + slot.offset, prefix.data(), prefix.size()) == 0)
+                {
+                    candidates.emplace_back(m_ids, slot.offset, slot.size);
+                }
+            }
+
+            std::sort(candidates.begin(), candidates.end());
+
+            std::string message = "Ambiguous option '" + prefix.str() + "' could be:";
+
+            for (const auto &candidate : candidates)
+            {
+                message += " " + candidate;
+            }
+
+            errors::raise<errors::AmbiguousOptionError>(message, candidates);
+        }
+
+        return option;
+    }
+
+
+    /**
+     * @brief Split the next segment off a command line token.
+     *
+     * Tokens which are an option ID or don't start with one are a single segment. Otherwise, in one pass
+     * from left to right:
+     *  - "--timeout=5" splits into the option "--timeout" and the value "5".
+     *  - "-vxf" splits into the options "-v", "-x" and "-f", if all of them exist. The segments of "-x"
+     *    and "-f" are the single characters "x" and "f".
+     *  - "-t5" and "-ofile" split into an option and a value: the rest of the token after an option which
+     *    takes a value is its value, even if it starts with short options. Otherwise the first character which
+     *    isn't a short option starts the value of the option before it.
+     *  - If abbreviations are allowed, "--verb" and "--verb=1" resolve to "--verbose".
+     *
+     * Segments are offsets into the token, nothing is copied.
+     *
+     * @param token The token.
+     * @param offset The offset of the segment: 0 for the first one, then the returned offset.
+     * @param segment Receives the segment.
+     *
+     * @return The offset of the next segment or #npos if this has been the last one.
+     * @throws #cppargparse::errors::AmbiguousOptionError if an abbreviation is ambiguous.
+     */
+    size_t split(const cmd::TokenView &token, const size_t offset, Segment &segment) const
+    {
+        if (offset == 0)
+        {
+            segment = Segment {0, token.size(), find(token)};
+
+            if (segment.option != npos || token.size() < 3 || token[0] != '-')
+            {
+                return npos;
+            }
+
+            if (token[1] == '-')
+            {
+                const char *equals = static_cast<const char *>(std::memchr(token.data(), '=', token.size()));
+                const size_t size = equals ? static_cast<size_t>(equals - token.data()) : token.size();
+                size_t option = equals ? find(cmd::TokenView(token.data(), size)) : npos;
+
+                if (option == npos && m_abbreviations && size > 2)
+                {
+                    option = find_abbreviation(cmd::TokenView(token.data(), size));
+                }
+
+                if (option == npos)
+                {
+                    return npos;
+                }
+
+                segment = Segment {0, size, option};
+                return equals ? size + 1 : npos;
+            }
+
+            const size_t option = find(cmd::TokenView(token.data(), 2));
+
+            if (option == npos)
+            {
+                return npos;
+            }
+
+            segment = Segment {0, 2, option};
+            return 2;
+        }
+
+        // The value after "--option="
+        if (token[1] == '-')
+        {
+            segment = Segment {offset, token.size() - offset, npos};
+            return npos;
+        }
+
+        // The value after a short option which takes one
+        const char previous[] = {'-', token[offset - 1]};
+        const size_t previous_option = find(cmd::TokenView(previous, 2));
+
+        if (previous_option != npos && m_takes_value[previous_option])
+        {
+            segment = Segment {offset, token.size() - offset, npos};
+            return npos;
+        }
+
+        const char id[] = {'-', token[offset]};
+        const size_t option = find(cmd::TokenView(id, 2));
+
+        if (option == npos)
+        {
+            segment = Segment {offset, token.size() - offset, npos};
+            return npos;
+        }
+
+        segment = Segment {offset, 1, option};
+        return (offset + 1 == token.size()) ? npos : offset + 1;
+    }
+
+
+    /**
+     * @brief Return the number of options.
+     *
+     * @return The number of options.
+     */
+    size_t size() const
+    {
+        return m_size;
+    }
+
+
+private:
+    /**
+     * @brief Internal: An ID inside the ID buffer and its option.
+     */
+    struct Slot
+    {
+        /// The ID offset inside the ID buffer
+        size_t offset;
+
+        /// The ID size
+        size_t size;
+
+        /// The option index, npos for free slots
+        size_t option;
+    };
+
+
+    /**
+     * @brief Internal: Return the slot holding an ID or the free slot where it belongs.
+     *
+     * @param id The ID.
+     *
+     * @return The slot index.
+     */
+    size_t lookup(const cmd::TokenView &id) const
+    {
+        const size_t mask = m_slots.size() - 1;
+        size_t slot = cmd::TokenViewHash()(id) & mask;
+
+        while (m_slots[slot].option != npos
+               && !(m_slots[slot].size == id.size() && std::memcmp(m_ids.data() + m_slots[slot].offset, id.data(), id.size()) == 0))
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        return slot;
+    }
+
+
+    /**
+     * @brief Internal: Map an ID to an option. A later option replaces an earlier one with the same ID.
+     *
+     * @param id The ID.
+     * @param option The option index.
+     */
+    void insert(const std::string &id, const size_t option)
+    {
+        // Keep the table at most half full
+        if ((m_count + 1) * 2 > m_slots.size())
+        {
+            std::vector<Slot> slots;
+            slots.swap(m_slots);
+            m_slots.assign(slots.empty() ? 16 : slots.size() * 2, Slot {0, 0, npos});
+
+            for (const Slot &slot : slots)
+            {
+                if (slot.option != npos)
+                {
+                    m_slots[lookup(cmd::TokenView(m_ids.data() + slot.offset, slot.size))] = slot;
+                }
+            }
+        }
+
+        Slot &slot = m_slots[lookup(cmd::TokenView(id))];
+
+        if (slot.option == npos)
+        {
+            slot.offset = m_ids.size();
+            slot.size = id.size();
+            m_ids.append(id);
+            ++m_count;
+        }
+
+        slot.option = option;
+    }
+
+
+    /// The option IDs, back to back
+    std::string m_ids;
+
+    /// The hash table over m_ids
+    std::vector<Slot> m_slots;
+
+    /// The number of IDs
+    size_t m_count;
+
+    /// The number of options
+    size_t m_size;
+
+    /// Per option: whether it takes a value
+    std::vector<bool> m_takes_value;
+
+    /// Whether split() accepts abbreviated long options
+    bool m_abbreviations;
+
+    /// Guards building the trie
+    mutable std::once_flag m_trie_once;
+
+    /// The trie over m_ids, built by the first find_abbreviation()
+    mutable trie::Trie m_trie;
+};
+
+
+/**
+ * @brief Collects options and compiles them into an immutable, shareable Schema.
+ *
+ * Example:
+ * @code
+ * schema::Builder builder;
+ * const size_t port = builder.add("-p", "--port");
+ * const auto schema = builder.build();
+ *
+ * // Per request, on any thread
+ * schema::Result result;
+ * schema::parse(*schema, argc, argv, result);
+ * @endcode
+ */
+class Builder
+{
+public:
+    /**
+     * @brief c'tor
+     */
+    Builder()
+        : m_schema(std::make_shared<Schema>())
+    {
+    }
+
+
+    /**
+     * @brief Add an option.
+     *
+     * @param id The option ID.
+     * @param id_alt The alternative option ID.
+     * @param takes_value Whether the option takes a value, see Schema::add().
+     *
+     * @return The option index, used to access the option's values in a Result.
+     */
+    size_t add(const std::string &id, const std::string &id_alt = std::string(), const bool takes_value = false)
+    {
+        return m_schema->add(id, id_alt, takes_value);
+    }
+
+
+    /**
+     * @brief Let the schema accept unique prefixes of long options, see Schema::allow_abbreviations().
+     *
+     * @param allowed Whether abbreviations are allowed.
+     */
+    void allow_abbreviations(const bool allowed = true)
+    {
+        m_schema->allow_abbreviations(allowed);
+    }
+
+
+    /**
+     * @brief Return the compiled schema and start a new, empty one.
+     *
+     * @return The schema. It can't be changed anymore, so it can be shared by any number of threads.
+     */
+    std::shared_ptr<const Schema> build()
+    {
+        std::shared_ptr<const Schema> schema = std::move(m_schema);
+        m_schema = std::make_shared<Schema>();
+
+        return schema;
+    }
+
+
+private:
+    /// The schema being built
+    std::shared_ptr<Schema> m_schema;
+};
+
+
+/**
+ * @brief The result of parsing one command line against a schema.
+ *
+ * Holds views into the parsed buffer, which must outlive the result, and token positions per option.
+ * Tokens are split by Schema::split(), so tokens() holds segments such as "-t" and "5" for "-t5".
+ * Clearing a result keeps its memory, so reusing it for the next parse doesn't allocate. Values of types
+ * with argument<T>::try_convert() are converted straight from the views.
+ */
+class Result
+{
+public:
+    /**
+     * @brief c'tor
+     */
+    Result()
+        : m_tokens()
+        , m_positions()
+        , m_ends()
+        , m_open(npos)
+    {
+    }
+
+
+    /**
+     * @brief Reset the result for a new parse, keeping its memory.
+     *
+     * @param option_count The number of options in the schema.
+     */
+    void clear(const size_t option_count)
+    {
+        m_tokens.clear();
+        m_positions.assign(option_count, npos);
+        m_ends.assign(option_count, npos);
+        m_open = npos;
+    }
+
+
+    /**
+     * @brief Return all tokens of the parsed command line.
+     *
+     * @return All tokens of the parsed command line.
+     */
+    const std::vector<cmd::TokenView> &tokens() const
+    {
+        return m_tokens;
+    }
+
+
+    /**
+     * @brief Return whether an option has been passed.
+     *
+     * @param option The option index.
+     *
+     * @return Whether the option has been passed.
+     */
+    bool get_flag(const size_t option) const
+    {
+        return m_positions[option] != npos;
+    }
+
+
+    /**
+     * @brief Return the number of values following an option.
+     *
+     * @param option The option index.
+     *
+     * @return The number of values following the option's first occurrence.
+     */
+    size_t value_count(const size_t option) const
+    {
+        return get_flag(option) ? m_ends[option] - m_positions[option] - 1 : 0;
+    }
+
+
+    /**
+     * @brief Return a value of an option.
+     *
+     * @param option The option index.
+     * @param index The value index. Must be less than value_count().
+     *
+     * @return The value token.
+     */
+    const cmd::TokenView &value(const size_t option, const size_t index = 0) const
+    {
+        return m_tokens[m_positions[option] + 1 + index];
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return the first value of an option, converted to T.
+     *
+     * @tparam T The value type. argument::convert() must be implemented for T.
+     *
+     * @param option The option index.
+     *
+     * @return The option value of type T.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the option hasn't been passed.
+     * @throws #cppargparse::errors::CommandLineOptionError if the option has no value or it cannot be converted.
+     */
+    const T get_option(const size_t option) const
+    {
+        if (!get_flag(option))
+        {
+            errors::raise<errors::CommandLineArgumentError>("Cannot find argument #" + std::to_string(option));
+        }
+
+        if (value_count(option) == 0)
+        {
+            errors::raise<errors::CommandLineOptionError>("Missing value for: " + m_tokens[m_positions[option]].str());
+        }
+
+        return convert<T>(value(option));
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return all values of an option, converted to T.
+     *
+     * @tparam T The value type. argument::convert() must be implemented for T.
+     *
+     * @param option The option index.
+     *
+     * @return The option values of type T. Empty if the option hasn't been passed.
+     * @throws #cppargparse::errors::CommandLineOptionError if a value cannot be converted.
+     */
+    const std::vector<T> get_values(const size_t option) const
+    {
+        std::vector<T> values;
+        values.reserve(value_count(option));
+
+        for (size_t i = 0; i < value_count(option); ++i)
+        {
+            values.emplace_back(convert<T>(value(option, i)));
+        }
+
+        return values;
+    }
+
+
+    /**
+     * @brief Internal: Append a token.
+     *
+     * @param token The token.
+     * @param option The option index of the token or #npos if it isn't an option.
+     */
+    void push(const cmd::TokenView &token, const size_t option)
+    {
+        if (option != npos)
+        {
+            close(m_tokens.size());
+
+            if (m_positions[option] == npos)
+            {
+                m_positions[option] = m_tokens.size();
+                m_open = option;
+            }
+        }
+
+        m_tokens.emplace_back(token);
+    }
+
+
+    /**
+     * @brief Internal: Finish parsing.
+     */
+    void finish()
+    {
+        close(m_tokens.size());
+    }
+
+
+private:
+    template <typename T>
+    /**
+     * @brief Internal: Convert a value token with argument<T>::try_convert(), without copying it.
+     *
+     * Falls back to argument<T>::convert() on errors, which raises the converter's error.
+     *
+     * @param token The value token.
+     *
+     * @return The value of type T.
+     */
+    static typename std::enable_if<result::has_try_convert<T>::value, T>::type convert(const cmd::TokenView &token)
+    {
+        T value;
+
+        if (argument<T>::try_convert(token.data(), token.data() + token.size(), value) == errors::Code::None)
+        {
+            return value;
+        }
+
+        return convert_copy<T>(token);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert a value token with argument<T>::convert().
+     *
+     * @param token The value token.
+     *
+     * @return The value of type T.
+     */
+    static typename std::enable_if<!result::has_try_convert<T>::value, T>::type convert(const cmd::TokenView &token)
+    {
+        return convert_copy<T>(token);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert a copy of a value token with argument<T>::convert().
+     *
+     * @param token The value token.
+     *
+     * @return The value of type T.
+     */
+    static T convert_copy(const cmd::TokenView &token)
+    {
+        const cmd::CommandLine_t slot {token.str()};
+
+        return argument<T>::convert(slot, slot.cbegin(), cmd::CommandLineArguments_t());
+    }
+
+
+    /**
+     * @brief Internal: End the value range of the currently open option.
+     *
+     * @param end The token index ending the range.
+     */
+    void close(const size_t end)
+    {
+        if (m_open != npos)
+        {
+            m_ends[m_open] = end;
+            m_open = npos;
+        }
+    }
+
+
+    /// The tokens of the parsed command line
+    std::vector<cmd::TokenView> m_tokens;
+
+    /// Per option: the token index of its first occurrence or npos
+    std::vector<size_t> m_positions;
+
+    /// Per option: the token index ending its value range
+    std::vector<size_t> m_ends;
+
+    /// The option whose value range is still open
+    size_t m_open;
+};
+
+
+/**
+ * @brief Internal: Append the segments of a token to a result.
+ *
+ * @param schema The compiled option schema.
+ * @param token The token.
+ * @param result The result.
+ */
+inline void push_token(const Schema &schema, const cmd::TokenView &token, Result &result)
+{
+    Segment segment;
+    size_t offset = 0;
+
+    do
+    {
+        offset = schema.split(token, offset, segment);
+        result.push(cmd::TokenView(token.data() + segment.offset, segment.size), segment.option);
+    }
+    while (offset != npos);
+}
+
+
+/**
+ * @brief Parse a NUL-separated command line buffer, e.g. the contents of /proc/<pid>/cmdline.
+ *
+ * Tokens are views into @p data, nothing is copied. A trailing NUL doesn't start an empty token.
+ *
+ * @param schema The compiled option schema.
+ * @param data The buffer.
+ * @param size The buffer size.
+ * @param result The result to fill. Previous contents are cleared.
+ *
+ * @throws #cppargparse::errors::AmbiguousOptionError if an abbreviation is ambiguous.
+ */
+inline void parse_cmdline(const Schema &schema, const char *data, const size_t size, Result &result)
+{
+    result.clear(schema.size());
+
+    const char *position = data;
+    const char *last = data + size;
+
+    while (position != last)
+    {
+        const char *end = static_cast<const char *>(std::memchr(position, '\0', static_cast<size_t>(last - position)));
+        const cmd::TokenView token(position, static_cast<size_t>((end ? end : last) - position));
+
+        push_token(schema, token, result);
+        position = end ? end + 1 : last;
+    }
+
+    result.finish();
+}
+
+
+/**
+ * @brief Parse a command line argument array.
+ *
+ * Tokens are views into @p argv, nothing is copied.
+ *
+ * @param schema The compiled option schema.
+ * @param argc The command line argument count.
+ * @param argv The command line argument array.
+ * @param result The result to fill. Previous contents are cleared.
+ *
+ * @throws #cppargparse::errors::AmbiguousOptionError if an abbreviation is ambiguous.
+ */
+inline void parse(const Schema &schema, const int argc, const char *const *argv, Result &result)
+{
+    result.clear(schema.size());
+
+    for (int i = 0; i < argc; ++i)
+    {
+        const cmd::TokenView token(argv[i], std::strlen(argv[i]));
+
+        push_token(schema, token, result);
+    }
+
+    result.finish();
+}
+
+
+/**
+ * @brief Parse one line of shell-like text, e.g. a command read from a socket or a console.
+ *
+ * The line is split by a tokenizer::Tokens holder, which honors quotes and backslash escapes.
+ * Reusing @p tokens and @p result for the next line doesn't allocate once they have grown.
+ *
+ * @param schema The compiled option schema.
+ * @param line The line. Must outlive @p tokens and @p result.
+ * @param tokens Receives the tokens. Must outlive @p result.
+ * @param result The result to fill. Previous contents are cleared.
+ *
+ * @throws #cppargparse::errors::TokenizerError if a quote isn't closed.
+ * @throws #cppargparse::errors::AmbiguousOptionError if an abbreviation is ambiguous.
+ */
+inline void parse_line(const Schema &schema, const cmd::TokenView &line, tokenizer::Tokens &tokens, Result &result)
+{
+    tokens.assign(line);
+    result.clear(schema.size());
+
+    for (const auto &token : tokens)
+    {
+        push_token(schema, token, result);
+    }
+
+    result.finish();
+}
+
+
+/**
+ * @brief Parse many NUL-separated command line buffers in parallel.
+ *
+ * Buffers are distributed over @p thread_count worker threads in small batches. No more threads are started
+ * than there are batches, and the calling thread is one of them. If a thread cannot be started, the threads
+ * started so far parse all buffers.
+ * Results are reused, so parsing the next batch of the same size doesn't allocate once they have grown.
+ *
+ * @param schema The compiled option schema.
+ * @param buffers The command line buffers.
+ * @param results The results. Resized to the number of buffers, results[i] belongs to buffers[i].
+ * @param thread_count The maximum number of worker threads. 0 uses std::thread::hardware_concurrency().
+ *
+ * @throws #cppargparse::errors::AmbiguousOptionError if an abbreviation is ambiguous. The remaining buffers
+ *         aren't parsed then.
+ */
+inline void parse_batch(
+        const Schema &schema,
+        const std::vector<cmd::TokenView> &buffers,
+        std::vector<Result> &results,
+        unsigned int thread_count = 0)
+{
+    constexpr size_t batch_size = 64;
+
+    results.resize(buffers.size());
+
+    if (thread_count == 0)
+    {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const size_t batch_count = (buffers.size() + batch_size - 1) / batch_size;
+    thread_count = static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(thread_count, batch_count)));
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto worker = [&]()
+    {
+        for (size_t first = next.fetch_add(batch_size); first < buffers.size(); first = next.fetch_add(batch_size))
+        {
+            const size_t last = std::min(first + batch_size, buffers.size());
+
+#if CPPARGPARSE_EXCEPTIONS
+            try
+            {
+                for (size_t i = first; i < last; ++i)
+                {
+                    parse_cmdline(schema, buffers[i].data(), buffers[i].size(), results[i]);
+                }
+            }
+
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(error_mutex);
+
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+
+                next.store(buffers.size());
+            }
+#else
+            for (size_t i = first; i < last; ++i)
+            {
+                parse_cmdline(schema, buffers[i].data(), buffers[i].size(), results[i]);
+            }
+#endif
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+
+#if CPPARGPARSE_EXCEPTIONS
+    try
+    {
+#endif
+        for (unsigned int i = 1; i < thread_count; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+#if CPPARGPARSE_EXCEPTIONS
+    }
+
+    catch (const std::system_error &)
+    {
+        // Out of threads: the threads started so far, joined below, take the remaining batches
+    }
+#endif
+
+    worker();
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+#if CPPARGPARSE_EXCEPTIONS
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+#endif
+}
+
+
+} // namespace schema
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_SCHEMA_H
@@ -0,0 +1,806 @@
+#ifndef CPPARGPARSE_SNAPSHOT_H
+#define CPPARGPARSE_SNAPSHOT_H
+
+/**
+  @file cppargparse/snapshot.h
+  @brief Freezing parse results into a position-independent blob for worker processes.
+ */
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+#include <cppargparse/parser.h>
+#include <cppargparse/result.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+namespace cppargparse {
+namespace snapshot {
+
+
+/**
+ * @brief The blob header.
+ *
+ * Layout of a blob, all offsets relative to the blob start:
+ * Header | Option[option_count], sorted by key | Value[value_count] | NUL-terminated strings
+ */
+struct Header
+{
+    /// "CPPAPSNP"
+    char magic[8];
+
+    /// The blob format version
+    uint32_t version;
+
+    /// The number of options
+    uint32_t option_count;
+
+    /// The number of values
+    uint32_t value_count;
+
+    /// Unused, always 0
+    uint32_t reserved;
+
+    /// The schema hash of the registered arguments
+    uint64_t schema_hash;
+
+    /// The blob size in bytes
+    uint64_t size;
+};
+
+
+/**
+ * @brief A frozen option.
+ */
+struct Option
+{
+    /// The option_key() of the IDs, the options are sorted by it
+    uint64_t key;
+
+    /// The offset of the option ID string
+    uint32_t id;
+
+    /// The offset of the alternative option ID string
+    uint32_t id_alt;
+
+    /// The cmd::Source which supplied the option
+    uint32_t source;
+
+    /// The get_flag() result
+    uint32_t flag;
+
+    /// The index of the first value
+    uint32_t first_value;
+
+    /// The number of values
+    uint32_t value_count;
+};
+
+
+/**
+ * @brief A frozen option value.
+ */
+struct Value
+{
+    /// The offset of the NUL-terminated value string
+    uint32_t offset;
+
+    /// The value length
+    uint32_t length;
+};
+
+
+/**
+ * @brief The blob format version.
+ */
+constexpr uint32_t version = 2;
+
+
+/**
+ * @brief Internal: Mix an ID into an FNV-1a hash, followed by a separator byte.
+ *
+ * @param hash The hash.
+ * @param id The ID.
+ * @param size The ID length.
+ */
+inline void mix(uint64_t &hash, const char *id, const size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(id[i]);
+        hash *= 1099511628211ull;
+    }
+
+    hash ^= 0xff;
+    hash *= 1099511628211ull;
+}
+
+
+/**
+ * @brief Return the schema hash of a set of arguments (FNV-1a over all IDs, in order).
+ *
+ * Parsers registering the same arguments in the same order have the same schema hash.
+ *
+ * @param cmdargs The command line arguments.
+ *
+ * @return The schema hash.
+ */
+inline uint64_t schema_hash(const cmd::CommandLineArguments_t &cmdargs)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    for (const auto &cmdarg : cmdargs)
+    {
+        mix(hash, cmdarg.id().data(), cmdarg.id().size());
+        mix(hash, cmdarg.id_alt().data(), cmdarg.id_alt().size());
+    }
+
+    return hash;
+}
+
+
+/**
+ * @brief Return the lookup key of an option (FNV-1a over its IDs).
+ *
+ * @param id The option ID.
+ * @param id_size The option ID length.
+ * @param id_alt The alternative option ID.
+ * @param id_alt_size The alternative option ID length.
+ *
+ * @return The lookup key.
+ */
+inline uint64_t option_key(const char *id, const size_t id_size, const char *id_alt, const size_t id_alt_size)
+{
+    uint64_t hash = 14695981039346656037ull;
+
+    mix(hash, id, id_size);
+    mix(hash, id_alt, id_alt_size);
+
+    return hash;
+}
+
+
+/**
+ * @brief Freeze the resolved values of all registered arguments into a blob.
+ *
+ * Values from every source (command line, environment, configuration file) are stored as strings
+ * and converted on access, exactly like the parser does. The options are sorted by option_key(), so
+ * View looks them up by binary search.
+ *
+ * @param arg_parser The argument parser.
+ *
+ * @return The blob. Can be copied to any address, e.g. a shared memory mapping.
+ */
+inline std::vector<char> freeze(parser::ArgumentParser &arg_parser)
+{
+    const cmd::CommandLineArguments_t &cmdargs = arg_parser.args();
+
+    std::vector<Option> options;
+    std::vector<Value> values;
+    std::string strings;
+
+    const auto add_string = [&strings](const std::string &s)
+    {
+        const uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.append(s.c_str(), s.size() + 1);
+
+        return offset;
+    };
+
+    std::vector<std::pair<uint32_t, uint32_t>> value_strings;
+
+    for (const auto &cmdarg : cmdargs)
+    {
+        Option option;
+        option.key = option_key(cmdarg.id().data(), cmdarg.id().size(), cmdarg.id_alt().data(), cmdarg.id_alt().size());
+        option.id = add_string(cmdarg.id());
+        option.id_alt = add_string(cmdarg.id_alt());
+        option.source = static_cast<uint32_t>(arg_parser.get_source(cmdarg));
+        option.flag = arg_parser.get_flag(cmdarg) ? 1 : 0;
+        option.first_value = static_cast<uint32_t>(value_strings.size());
+        option.value_count = 0;
+
+        if (option.source != static_cast<uint32_t>(cmd::Source::Default))
+        {
+            for (const auto &value : arg_parser.get_option<std::vector<std::string>>(cmdarg))
+            {
+                value_strings.emplace_back(add_string(value), static_cast<uint32_t>(value.size()));
+                ++option.value_count;
+            }
+        }
+
+        options.emplace_back(option);
+    }
+
+    std::stable_sort(options.begin(), options.end(), [](const Option &a, const Option &b)
+    {
+        return a.key < b.key;
+    });
+
+    const size_t strings_offset = sizeof(Header) + options.size() * sizeof(Option) + value_strings.size() * sizeof(Value);
+
+    for (auto &option : options)
+    {
+        option.id += static_cast<uint32_t>(strings_offset);
+        option.id_alt += static_cast<uint32_t>(strings_offset);
+    }
+
+    for (const auto &value_string : value_strings)
+    {
+        values.emplace_back(Value {static_cast<uint32_t>(strings_offset + value_string.first), value_string.second});
+    }
+
+    Header header;
+    std::memcpy(header.magic, "CPPAPSNP", sizeof(header.magic));
+    header.version = version;
+    header.option_count = static_cast<uint32_t>(options.size());
+    header.value_count = static_cast<uint32_t>(values.size());
+    header.reserved = 0;
+    header.schema_hash = schema_hash(cmdargs);
+    header.size = strings_offset + strings.size();
+
+    std::vector<char> blob(static_cast<size_t>(header.size));
+    char *out = blob.data();
+
+    std::memcpy(out, &header, sizeof(Header));
+    out += sizeof(Header);
+
+    if (!options.empty())
+    {
+        std::memcpy(out, options.data(), options.size() * sizeof(Option));
+        out += options.size() * sizeof(Option);
+    }
+
+    if (!values.empty())
+    {
+        std::memcpy(out, values.data(), values.size() * sizeof(Value));
+        out += values.size() * sizeof(Value);
+    }
+
+    std::memcpy(out, strings.data(), strings.size());
+
+    return blob;
+}
+
+
+/**
+ * @brief Write a blob to an anonymous shared memory file.
+ *
+ * Uses a sealed memfd on Linux and an unlinked temporary file elsewhere.
+ * The returned file descriptor can be inherited by forked or spawned workers and mapped via io::MappedFile.
+ *
+ * @param blob The blob.
+ *
+ * @return The file descriptor.
+ * @throws #cppargparse::errors::SnapshotError if the file cannot be created or written.
+ */
+inline int write_shared(const std::vector<char> &blob)
+{
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+    const int fd = ::memfd_create("cppargparse-snapshot", MFD_ALLOW_SEALING);
+#else
+    std::FILE *file = std::tmpfile();
+    const int fd = file ? ::dup(::fileno(file)) : -1;
+
+    if (file)
+    {
+        std::fclose(file);
+    }
+#endif
+
+    if (fd < 0)
+    {
+        errors::raise<errors::SnapshotError>("Cannot create shared memory file");
+    }
+
+    size_t written = 0;
+
+    while (written < blob.size())
+    {
+        const auto count = ::write(fd, blob.data() + written, blob.size() - written);
+
+        if (count <= 0)
+        {
+            ::close(fd);
+            errors::raise<errors::SnapshotError>("Cannot write shared memory file");
+        }
+
+        written += static_cast<size_t>(count);
+    }
+
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+    ::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+#endif
+
+    return fd;
+}
+
+
+/**
+ * @brief A read-only view of a frozen parse result.
+ *
+ * Offers the typed accessors of ArgumentParser without parsing the command line again.
+ * The view doesn't copy the blob, which must outlive it. All records are validated once on construction,
+ * lookups are binary searches over the options and values of types with argument<T>::try_convert()
+ * are converted straight from the blob.
+ */
+class View
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param data The blob.
+     * @param size The blob size.
+     * @param expected_schema_hash The schema_hash() of the arguments the reader expects.
+     *
+     * @throws #cppargparse::errors::SnapshotError if the blob is malformed or was frozen with a different schema.
+     */
+    View(const char *data, const size_t size, const uint64_t expected_schema_hash)
+        : m_data(data)
+        , m_size(size)
+        , m_header()
+    {
+        if (!data || size < sizeof(Header))
+        {
+            errors::raise<errors::SnapshotError>("Snapshot too small");
+        }
+
+        std::memcpy(&m_header, data, sizeof(Header));
+
+        if (std::memcmp(m_header.magic, "CPPAPSNP", sizeof(m_header.magic)) != 0 || m_header.version != version)
+        {
+            errors::raise<errors::SnapshotError>("Not a snapshot or unsupported snapshot version");
+        }
+
+        if (m_header.size != size || strings_offset() > size)
+        {
+            errors::raise<errors::SnapshotError>("Snapshot size mismatch");
+        }
+
+        if (m_header.schema_hash != expected_schema_hash)
+        {
+            errors::raise<errors::SnapshotError>("Snapshot schema mismatch");
+        }
+
+        validate();
+    }
+
+
+    /**
+     * @brief Return the number of frozen options.
+     *
+     * @return The number of frozen options.
+     */
+    size_t size() const
+    {
+        return m_header.option_count;
+    }
+
+
+    /**
+     * @brief Return whether a flag has been set.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The frozen get_flag() result.
+     */
+    bool get_flag(const cmd::CommandLineArgument &cmdarg) const
+    {
+        Option option;
+        return find(cmdarg, option) && option.flag != 0;
+    }
+
+
+    /**
+     * @brief Return the source which supplied an argument's value.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The frozen get_source() result.
+     */
+    cmd::Source get_source(const cmd::CommandLineArgument &cmdarg) const
+    {
+        Option option;
+        return find(cmdarg, option) ? static_cast<cmd::Source>(option.source) : cmd::Source::Default;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return the argument value of type T.
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument.
+     *
+     * @return The argument value of type T.
+     * @throws #cppargparse::errors::CommandLineArgumentError if the argument cannot be found.
+     */
+    const T get_option(const cmd::CommandLineArgument &cmdarg) const
+    {
+        Option option;
+
+        if (!find(cmdarg, option) || option.source == static_cast<uint32_t>(cmd::Source::Default))
+        {
+            errors::raise<errors::CommandLineArgumentError>("Cannot find argument: " + cmdarg.id());
+        }
+
+        return convert<T>(cmdarg, option);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return an argument value.
+     *
+     * @tparam T The argument type. argument::parse() and argument::convert() must be implemented for T.
+     *
+     * @param cmdarg The command line argument.
+     * @param default_value The default argument value of type T.
+     *
+     * @return The argument value of type T or the default value if the argument cannot be found or converted.
+     */
+    const T get_option(const cmd::CommandLineArgument &cmdarg, const T &default_value) const
+    {
+        Option option;
+
+        if (!find(cmdarg, option) || option.source == static_cast<uint32_t>(cmd::Source::Default))
+        {
+            return default_value;
+        }
+
+        return convert_or<T>(cmdarg, option, default_value);
+    }
+
+
+private:
+    template <typename T>
+    /**
+     * @brief Internal: Read a record from the blob, independent of its alignment.
+     *
+     * @param offset The record offset. Must lie inside the blob.
+     *
+     * @return The record.
+     */
+    T read(const uint64_t offset) const
+    {
+        T record;
+        std::memcpy(&record, m_data + offset, sizeof(T));
+
+        return record;
+    }
+
+
+    /**
+     * @brief Internal: Return a frozen option.
+     *
+     * @param index The option index.
+     *
+     * @return The option.
+     */
+    Option option_at(const uint32_t index) const
+    {
+        return read<Option>(sizeof(Header) + static_cast<uint64_t>(index) * sizeof(Option));
+    }
+
+
+    /**
+     * @brief Internal: Return a frozen value.
+     *
+     * @param index The value index.
+     *
+     * @return The value.
+     */
+    Value value_at(const uint32_t index) const
+    {
+        return read<Value>(values_offset() + static_cast<uint64_t>(index) * sizeof(Value));
+    }
+
+
+    /**
+     * @brief Internal: Return the offset of the value records.
+     *
+     * @return The offset of the value records.
+     */
+    uint64_t values_offset() const
+    {
+        return sizeof(Header) + static_cast<uint64_t>(m_header.option_count) * sizeof(Option);
+    }
+
+
+    /**
+     * @brief Internal: Return the offset of the strings.
+     *
+     * @return The offset of the strings.
+     */
+    uint64_t strings_offset() const
+    {
+        return values_offset() + static_cast<uint64_t>(m_header.value_count) * sizeof(Value);
+    }
+
+
+    /**
+     * @brief Internal: Return whether a NUL-terminated string lies inside the string area.
+     *
+     * @param offset The string offset.
+     *
+     * @return Whether the string is valid.
+     */
+    bool valid_string(const uint64_t offset) const
+    {
+        return offset >= strings_offset() && offset < m_size && std::memchr(m_data + offset, '\0', m_size - offset);
+    }
+
+
+    /**
+     * @brief Internal: Validate all options and values, so accessors can read them unchecked.
+     *
+     * @throws #cppargparse::errors::SnapshotError if a record is malformed.
+     */
+    void validate() const
+    {
+        uint64_t previous_key = 0;
+
+        for (uint32_t i = 0; i < m_header.option_count; ++i)
+        {
+            const Option option = option_at(i);
+
+            if (!valid_string(option.id) || !valid_string(option.id_alt))
+            {
+                errors::raise<errors::SnapshotError>("Snapshot string out of bounds");
+            }
+
+            const char *id = m_data + option.id;
+            const char *id_alt = m_data + option.id_alt;
+
+            if (option.key != option_key(id, std::strlen(id), id_alt, std::strlen(id_alt))
+                    || (i > 0 && option.key < previous_key)
+                    || option.source > static_cast<uint32_t>(cmd::Source::Default)
+                    || static_cast<uint64_t>(option.first_value) + option.value_count > m_header.value_count)
+            {
+                errors::raise<errors::SnapshotError>("Snapshot option malformed");
+            }
+
+            previous_key = option.key;
+        }
+
+        for (uint32_t i = 0; i < m_header.value_count; ++i)
+        {
+            const Value value = value_at(i);
+            const uint64_t end = static_cast<uint64_t>(value.offset) + value.length;
+
+            if (value.offset < strings_offset() || end >= m_size || m_data[end] != '\0')
+            {
+                errors::raise<errors::SnapshotError>("Snapshot record out of bounds");
+            }
+        }
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert the first value of an option with argument<T>::try_convert(), without copying it.
+     *
+     * @param option The frozen option.
+     * @param value Receives the value.
+     *
+     * @return Whether the option has a value which could be converted.
+     */
+    bool try_convert(const Option &option, T &value) const
+    {
+        if (option.value_count == 0)
+        {
+            return false;
+        }
+
+        const Value first = value_at(option.first_value);
+        const char *data = m_data + first.offset;
+
+        return argument<T>::try_convert(data, data + first.length, value) == errors::Code::None;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert an option value with argument<T>::try_convert().
+     *
+     * Falls back to argument<T>::parse() on errors, which raises the converter's error.
+     *
+     * @param cmdarg The command line argument.
+     * @param option The frozen option.
+     *
+     * @return The value of type T.
+     */
+    typename std::enable_if<result::has_try_convert<T>::value, T>::type convert(
+            const cmd::CommandLineArgument &cmdarg,
+            const Option &option) const
+    {
+        T value;
+
+        if (try_convert(option, value))
+        {
+            return value;
+        }
+
+        return convert_copy<T>(cmdarg, option);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert an option value with argument<T>::parse().
+     *
+     * @param cmdarg The command line argument.
+     * @param option The frozen option.
+     *
+     * @return The value of type T.
+     */
+    typename std::enable_if<!result::has_try_convert<T>::value, T>::type convert(
+            const cmd::CommandLineArgument &cmdarg,
+            const Option &option) const
+    {
+        return convert_copy<T>(cmdarg, option);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert an option value with argument<T>::try_convert(), without raising.
+     *
+     * @param option The frozen option.
+     * @param default_value The default value.
+     *
+     * @return The value of type T or the default value if it cannot be converted.
+     */
+    typename std::enable_if<result::has_try_convert<T>::value, T>::type convert_or(
+            const cmd::CommandLineArgument &,
+            const Option &option,
+            const T &default_value) const
+    {
+        T value;
+        return try_convert(option, value) ? value : default_value;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert an option value with result::try_parse(), without raising.
+     *
+     * @param cmdarg The command line argument.
+     * @param option The frozen option.
+     * @param default_value The default value.
+     *
+     * @return The value of type T or the default value if it cannot be converted.
+     */
+    typename std::enable_if<!result::has_try_convert<T>::value, T>::type convert_or(
+            const cmd::CommandLineArgument &cmdarg,
+            const Option &option,
+            const T &default_value) const
+    {
+        const cmd::CommandLine_t cmd = entry(cmdarg, option);
+        return result::try_parse<T>(cmd, cmd.cbegin(), cmd::CommandLineArguments_t()).value_or(default_value);
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Convert a rebuilt command line of an option with argument<T>::parse().
+     *
+     * @param cmdarg The command line argument.
+     * @param option The frozen option.
+     *
+     * @return The value of type T.
+     */
+    T convert_copy(const cmd::CommandLineArgument &cmdarg, const Option &option) const
+    {
+        const cmd::CommandLine_t cmd = entry(cmdarg, option);
+        return argument<T>::parse(cmd, cmd.cbegin(), cmd::CommandLineArguments_t());
+    }
+
+
+    /**
+     * @brief Internal: Rebuild the small command line (id, values...) of a frozen option.
+     *
+     *
+     * @param cmdarg The command line argument.
+     * @param option The frozen option.
+     *
+     * @return The command line.
+     */
+    cmd::CommandLine_t entry(const cmd::CommandLineArgument &cmdarg, const Option &option) const
+    {
+        cmd::CommandLine_t cmd;
+        cmd.reserve(option.value_count + 1);
+        cmd.emplace_back(cmdarg.id());
+
+        for (uint32_t i = 0; i < option.value_count; ++i)
+        {
+            const Value value = value_at(option.first_value + i);
+            cmd.emplace_back(m_data + value.offset, value.length);
+        }
+
+        return cmd;
+    }
+
+
+    /**
+     * @brief Internal: Find the frozen option for an argument by binary search over the option keys.
+     *
+     * @param cmdarg The command line argument.
+     * @param option Receives the frozen option.
+     *
+     * @return Whether the option has been found.
+     */
+    bool find(const cmd::CommandLineArgument &cmdarg, Option &option) const
+    {
+        const std::string &id = cmdarg.id();
+        const std::string &id_alt = cmdarg.id_alt();
+        const uint64_t key = option_key(id.data(), id.size(), id_alt.data(), id_alt.size());
+
+        uint32_t first = 0;
+        uint32_t count = m_header.option_count;
+
+        while (count > 0)
+        {
+            const uint32_t half = count / 2;
+
+            if (option_at(first + half).key < key)
+            {
+                first += half + 1;
+                count -= half + 1;
+            }
+            else
+            {
+                count = half;
+            }
+        }
+
+        // Options with colliding keys are adjacent
+        for (; first < m_header.option_count; ++first)
+        {
+            option = option_at(first);
+
+            if (option.key != key)
+            {
+                break;
+            }
+
+            if (id == m_data + option.id && id_alt == m_data + option.id_alt)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+
+    /// The blob
+    const char *m_data;
+
+    /// The blob size
+    size_t m_size;
+
+    /// A copy of the blob header
+    Header m_header;
+};
+
+
+} // namespace snapshot
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_SNAPSHOT_H
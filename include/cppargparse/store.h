@@ -0,0 +1,452 @@
+#ifndef CPPARGPARSE_STORE_H
+#define CPPARGPARSE_STORE_H
+
+/**
+  @file cppargparse/store.h
+  @brief Looking up arguments by ID and storing one typed value per argument.
+ */
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cppargparse/cache.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+
+
+namespace cppargparse {
+namespace store {
+
+
+/**
+ * @brief The index of IDs which don't belong to any argument.
+ */
+constexpr size_t npos = errors::npos;
+
+
+/**
+ * @brief A hash index from argument IDs to argument indexes.
+ *
+ * The index holds only argument indexes in a flat open addressing table and compares IDs against the
+ * argument list itself, so it stays valid when the list is copied along with it. Lookups take a
+ * cmd::TokenView and never allocate.
+ *
+ * A bloom filter of 4 bits per table slot sits in front of the table. The table is kept between a quarter
+ * and half full, so that's 8 to 16 bits per ID, and most lookups of unknown IDs are answered from one word
+ * without probing the table or comparing strings.
+ */
+class Index
+{
+public:
+    /**
+     * @brief c'tor
+     */
+    Index()
+        : m_slots()
+        , m_filter()
+        , m_size(0)
+    {
+    }
+
+
+    /**
+     * @brief Add an argument. Arguments must be added in the order of the argument list.
+     *
+     * Arguments without ID (positional arguments) are skipped. If an ID is taken already,
+     * it keeps referring to the earlier argument.
+     *
+     * @param cmdargs The argument list, which holds the argument.
+     * @param argument The argument index inside @p cmdargs.
+     */
+    void insert(const cmd::CommandLineArguments_t &cmdargs, const size_t argument)
+    {
+        // Keep the table at most half full
+        if ((m_size + 2) * 2 > m_slots.size())
+        {
+            m_slots.assign(m_slots.empty() ? 16 : m_slots.size() * 2, 0);
+            m_filter.assign(m_slots.size() / 16, 0);
+            m_size = 0;
+
+            for (size_t i = 0; i < argument; ++i)
+            {
+                place(cmdargs, i);
+            }
+        }
+
+        place(cmdargs, argument);
+    }
+
+
+    /**
+     * @brief Find an argument by ID or alternative ID.
+     *
+     * @param cmdargs The argument list the index has been built for.
+     * @param id The ID.
+     *
+     * @return The argument index or #npos if no argument has this ID.
+     */
+    size_t find(const cmd::CommandLineArguments_t &cmdargs, const cmd::TokenView &id) const
+    {
+        if (m_slots.empty() || id.empty())
+        {
+            return npos;
+        }
+
+        const size_t hash = cmd::TokenViewHash()(id);
+
+        if (!may_contain(hash))
+        {
+            return npos;
+        }
+
+        const size_t mask = m_slots.size() - 1;
+
+        for (size_t slot = hash & mask; m_slots[slot] != 0; slot = (slot + 1) & mask)
+        {
+            const auto &cmdarg = cmdargs[m_slots[slot] - 1];
+
+            if (id == cmd::TokenView(cmdarg.id()) || id == cmd::TokenView(cmdarg.id_alt()))
+            {
+                return m_slots[slot] - 1;
+            }
+        }
+
+        return npos;
+    }
+
+
+private:
+    /**
+     * @brief Internal: Return the two filter bits of a hash.
+     */
+    std::pair<size_t, size_t> filter_bits(const size_t hash) const
+    {
+        const size_t mask = m_filter.size() * 64 - 1;
+
+        return std::make_pair(hash & mask, (hash >> 24) & mask);
+    }
+
+
+    /**
+     * @brief Internal: Return whether the filter may contain an ID hash.
+     */
+    bool may_contain(const size_t hash) const
+    {
+        const auto bits = filter_bits(hash);
+
+        return (m_filter[bits.first / 64] >> (bits.first % 64) & 1) && (m_filter[bits.second / 64] >> (bits.second % 64) & 1);
+    }
+
+
+    /**
+     * @brief Internal: Put the IDs of an argument into free slots.
+     */
+    void place(const cmd::CommandLineArguments_t &cmdargs, const size_t argument)
+    {
+        const auto &cmdarg = cmdargs[argument];
+
+        for (const std::string *id : {&cmdarg.id(), &cmdarg.id_alt()})
+        {
+            if (id->empty() || find(cmdargs, cmd::TokenView(*id)) != npos)
+            {
+                continue;
+            }
+
+            const size_t hash = cmd::TokenViewHash()(cmd::TokenView(*id));
+            const auto bits = filter_bits(hash);
+
+            m_filter[bits.first / 64] |= std::uint64_t(1) << (bits.first % 64);
+            m_filter[bits.second / 64] |= std::uint64_t(1) << (bits.second % 64);
+
+            const size_t mask = m_slots.size() - 1;
+            size_t slot = hash & mask;
+
+            while (m_slots[slot] != 0)
+            {
+                slot = (slot + 1) & mask;
+            }
+
+            m_slots[slot] = argument + 1;
+            ++m_size;
+        }
+    }
+
+
+    /// The table: argument index + 1, 0 for free slots
+    std::vector<size_t> m_slots;
+
+    /// The bloom filter over the IDs in the table, 4 bits per slot (8 to 16 bits per ID)
+    std::vector<std::uint64_t> m_filter;
+
+    /// The number of occupied slots
+    size_t m_size;
+};
+
+
+/**
+ * @brief One value per argument, stored in a contiguous slot array indexed by argument index.
+ *
+ * Each slot remembers the type it has been filled with, as a cache::type_id(), so values are
+ * read back with a type check but without RTTI. Values of up to inline_size bytes are constructed
+ * in the slot itself; only larger or over-aligned types fall back to one heap allocation each.
+ * The slot array is allocated once for all arguments, so stored values never move until clear().
+ */
+class Store
+{
+public:
+    /// The largest value size stored inline, in bytes
+    static constexpr size_t inline_size = 4 * sizeof(void *);
+
+
+    /**
+     * @brief c'tor
+     */
+    Store()
+        : m_slots()
+    {
+    }
+
+
+    /**
+     * @brief Return the type of the value stored for an argument.
+     *
+     * @param argument The argument index.
+     *
+     * @return The type ID or nullptr if there is no value.
+     */
+    cache::TypeId_t type(const size_t argument) const
+    {
+        return (argument < m_slots.size()) ? m_slots[argument].type : nullptr;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Return the value stored for an argument.
+     *
+     * @tparam T The value type. Must be the type the value has been stored as.
+     *
+     * @param argument The argument index.
+     *
+     * @return The value or nullptr if there is no value of type T.
+     */
+    const T *find(const size_t argument) const
+    {
+        return (type(argument) == cache::type_id<T>()) ? Holder<T>::get(m_slots[argument]) : nullptr;
+    }
+
+
+    template <typename T>
+    /**
+     * @brief Store the value of an argument, replacing a previous value.
+     *
+     * @tparam T The value type.
+     *
+     * @param argument The argument index.
+     * @param count The number of arguments. The slot array is sized for all of them on the first call.
+     * @param value The value.
+     *
+     * @return The stored value.
+     */
+    const T &put(const size_t argument, const size_t count, T value)
+    {
+        if (argument >= m_slots.size())
+        {
+            m_slots.resize(std::max(argument + 1, count));
+        }
+
+        Slot &slot = m_slots[argument];
+        slot.reset();
+        Holder<T>::create(slot, std::move(value));
+        slot.type = cache::type_id<T>();
+        slot.operations = &Holder<T>::operations;
+
+        return *Holder<T>::get(slot);
+    }
+
+
+    /**
+     * @brief Remove all values.
+     */
+    void clear()
+    {
+        m_slots.clear();
+    }
+
+
+private:
+    struct Slot;
+
+
+    /**
+     * @brief Internal: The type-specific operations of a filled slot.
+     */
+    struct Operations
+    {
+        /// Copy-construct the value of the first slot into the empty second slot
+        void (*copy)(const Slot &, Slot &);
+
+        /// Destroy the value of a slot
+        void (*destroy)(Slot &);
+    };
+
+
+    /// The inline storage of a slot
+    typedef typename std::aligned_storage<inline_size, alignof(std::max_align_t)>::type Buffer_t;
+
+
+    /**
+     * @brief Internal: A value, its type ID and its operations.
+     */
+    struct Slot
+    {
+        Slot()
+            : type(nullptr)
+            , operations(nullptr)
+            , buffer()
+        {
+        }
+
+
+        Slot(const Slot &other)
+            : type(nullptr)
+            , operations(nullptr)
+            , buffer()
+        {
+            *this = other;
+        }
+
+
+        Slot &operator=(const Slot &other)
+        {
+            if (this != &other)
+            {
+                reset();
+
+                if (other.type)
+                {
+                    other.operations->copy(other, *this);
+                    type = other.type;
+                    operations = other.operations;
+                }
+            }
+
+            return *this;
+        }
+
+
+        ~Slot()
+        {
+            reset();
+        }
+
+
+        /**
+         * @brief Destroy the value, if any.
+         */
+        void reset()
+        {
+            if (type)
+            {
+                operations->destroy(*this);
+                type = nullptr;
+                operations = nullptr;
+            }
+        }
+
+
+        /// The type ID, nullptr for empty slots
+        cache::TypeId_t type;
+
+        /// The operations for the value's type, nullptr for empty slots
+        const Operations *operations;
+
+        /// The value, or a pointer to it if it doesn't fit
+        Buffer_t buffer;
+    };
+
+
+    template <typename T, bool Inline = (sizeof(T) <= sizeof(Buffer_t) && alignof(T) <= alignof(Buffer_t))>
+    /**
+     * @brief Internal: Stores values of type T in the slot buffer.
+     */
+    struct Holder
+    {
+        static const T *get(const Slot &slot)
+        {
+            return reinterpret_cast<const T *>(&slot.buffer);
+        }
+
+        static void create(Slot &slot, T value)
+        {
+            new (&slot.buffer) T(std::move(value));
+        }
+
+        static void copy(const Slot &from, Slot &to)
+        {
+            new (&to.buffer) T(*get(from));
+        }
+
+        static void destroy(Slot &slot)
+        {
+            reinterpret_cast<T *>(&slot.buffer)->~T();
+        }
+
+        static const Operations operations;
+    };
+
+
+    template <typename T>
+    /**
+     * @brief Internal: Stores values of type T on the heap, with the pointer in the slot buffer.
+     */
+    struct Holder<T, false>
+    {
+        static const T *get(const Slot &slot)
+        {
+            return *reinterpret_cast<T *const *>(&slot.buffer);
+        }
+
+        static void create(Slot &slot, T value)
+        {
+            *reinterpret_cast<T **>(&slot.buffer) = new T(std::move(value));
+        }
+
+        static void copy(const Slot &from, Slot &to)
+        {
+            *reinterpret_cast<T **>(&to.buffer) = new T(*get(from));
+        }
+
+        static void destroy(Slot &slot)
+        {
+            delete *reinterpret_cast<T **>(&slot.buffer);
+        }
+
+        static const Operations operations;
+    };
+
+
+    /// The values, indexed by argument index
+    std::vector<Slot> m_slots;
+};
+
+
+template <typename T, bool Inline>
+const Store::Operations Store::Holder<T, Inline>::operations = {&Store::Holder<T, Inline>::copy, &Store::Holder<T, Inline>::destroy};
+
+template <typename T>
+const Store::Operations Store::Holder<T, false>::operations = {&Store::Holder<T, false>::copy, &Store::Holder<T, false>::destroy};
+
+
+} // namespace store
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_STORE_H
@@ -0,0 +1,383 @@
+#ifndef CPPARGPARSE_STREAM_H
+#define CPPARGPARSE_STREAM_H
+
+/**
+  @file cppargparse/stream.h
+  @brief Streaming tokens from a file descriptor (xargs style).
+ */
+
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <cppargparse/argument/argument.h>
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#define CPPARGPARSE_READ ::_read
+#else
+#include <unistd.h>
+#define CPPARGPARSE_READ ::read
+#endif
+
+
+namespace cppargparse {
+namespace stream {
+
+
+/**
+ * @brief The default number of bytes read from the file descriptor at once.
+ */
+constexpr size_t default_chunk_size = 64 * 1024;
+
+
+class TokenIterator;
+
+
+/**
+ * @brief Reads delimiter-separated tokens from a file descriptor in large chunks.
+ *
+ * Only one chunk is held in memory, no matter how many tokens arrive. The buffer only grows
+ * if a single token is longer than the chunk size.
+ *
+ * Example: find -print0 | tool --files -
+ */
+class TokenReader
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * @param fd The file descriptor to read from. Not closed by the reader.
+     * @param delimiter The token delimiter: '\0' or '\n'. For '\n', a trailing '\r' is stripped and empty lines are skipped.
+     * @param chunk_size The number of bytes to read at once.
+     */
+    explicit TokenReader(const int fd = 0, const char delimiter = '\0', const size_t chunk_size = default_chunk_size)
+        : m_fd(fd)
+        , m_delimiter(delimiter)
+        , m_buffer(chunk_size > 0 ? chunk_size : 1)
+        , m_begin(0)
+        , m_end(0)
+        , m_eof(false)
+    {
+    }
+
+
+    /**
+     * @brief Read the next token.
+     *
+     * @param token Receives the token. The view is valid until the next call.
+     *
+     * @return Whether a token has been read. false at the end of the stream.
+     * @throws #cppargparse::errors::StreamError if reading from the file descriptor fails.
+     */
+    bool next(cmd::TokenView &token)
+    {
+        while (true)
+        {
+            const char *first = m_buffer.data() + m_begin;
+            const char *delimiter = static_cast<const char *>(std::memchr(first, m_delimiter, m_end - m_begin));
+
+            if (delimiter || (m_eof && m_begin != m_end))
+            {
+                const char *last = delimiter ? delimiter : m_buffer.data() + m_end;
+                m_begin = delimiter ? m_begin + static_cast<size_t>(delimiter - first) + 1 : m_end;
+
+                if (m_delimiter == '\n')
+                {
+                    if (last != first && last[-1] == '\r')
+                    {
+                        --last;
+                    }
+
+                    if (last == first)
+                    {
+                        continue;
+                    }
+                }
+
+                token = cmd::TokenView(first, static_cast<size_t>(last - first));
+                return true;
+            }
+
+            if (m_eof)
+            {
+                return false;
+            }
+
+            fill();
+        }
+    }
+
+
+    template <typename Callback>
+    /**
+     * @brief Read all remaining tokens and call a callback for each of them.
+     *
+     * @tparam Callback The callback type: void(const cmd::TokenView &).
+     *
+     * @param callback The callback. The view is only valid during the call.
+     *
+     * @return The number of tokens read.
+     * @throws #cppargparse::errors::StreamError if reading from the file descriptor fails.
+     */
+    size_t for_each(Callback callback)
+    {
+        size_t count = 0;
+        cmd::TokenView token;
+
+        while (next(token))
+        {
+            callback(token);
+            ++count;
+        }
+
+        return count;
+    }
+
+
+    /**
+     * @brief Return an input iterator to the next token.
+     *
+     * @return An input iterator to the next token.
+     */
+    TokenIterator begin();
+
+
+    /**
+     * @brief Return the end-of-stream iterator.
+     *
+     * @return The end-of-stream iterator.
+     */
+    TokenIterator end();
+
+
+private:
+    /**
+     * @brief Internal: Move the unread bytes to the front of the buffer and read the next chunk.
+     *
+     * @throws #cppargparse::errors::StreamError if reading from the file descriptor fails.
+     */
+    void fill()
+    {
+        if (m_begin > 0)
+        {
+            std::memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+            m_end -= m_begin;
+            m_begin = 0;
+        }
+
+        if (m_end == m_buffer.size())
+        {
+            m_buffer.resize(m_buffer.size() * 2);
+        }
+
+        while (true)
+        {
+            const auto count = CPPARGPARSE_READ(m_fd, m_buffer.data() + m_end, m_buffer.size() - m_end);
+
+            if (count > 0)
+            {
+                m_end += static_cast<size_t>(count);
+                return;
+            }
+
+            if (count == 0)
+            {
+                m_eof = true;
+                return;
+            }
+
+            if (errno != EINTR)
+            {
+                errors::raise<errors::StreamError>(std::string("Cannot read token stream: ") + std::strerror(errno));
+            }
+        }
+    }
+
+
+    /// The file descriptor to read from
+    const int m_fd;
+
+    /// The token delimiter
+    const char m_delimiter;
+
+    /// The read buffer
+    std::vector<char> m_buffer;
+
+    /// The first unread byte inside m_buffer
+    size_t m_begin;
+
+    /// The end of the valid bytes inside m_buffer
+    size_t m_end;
+
+    /// Whether the end of the stream has been reached
+    bool m_eof;
+};
+
+
+/**
+ * @brief Input iterator over the tokens of a TokenReader.
+ *
+ * Tokens are read lazily as the iterator advances. The referenced view is valid until the next increment.
+ */
+class TokenIterator
+{
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef cmd::TokenView value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const cmd::TokenView *pointer;
+    typedef const cmd::TokenView &reference;
+
+
+    /**
+     * @brief c'tor
+     *
+     * Creates the end-of-stream iterator.
+     */
+    TokenIterator()
+        : m_reader(nullptr)
+        , m_token()
+    {
+    }
+
+
+    /**
+     * @brief c'tor
+     *
+     * @param reader The token reader. The first token is read immediately.
+     */
+    explicit TokenIterator(TokenReader &reader)
+        : m_reader(&reader)
+        , m_token()
+    {
+        ++(*this);
+    }
+
+
+    /**
+     * @brief Return the current token.
+     *
+     * @return The current token.
+     */
+    const cmd::TokenView &operator*() const
+    {
+        return m_token;
+    }
+
+
+    /**
+     * @brief Return the current token.
+     *
+     * @return The current token.
+     */
+    const cmd::TokenView *operator->() const
+    {
+        return &m_token;
+    }
+
+
+    /**
+     * @brief Read the next token.
+     *
+     * @return This iterator.
+     */
+    TokenIterator &operator++()
+    {
+        if (m_reader && !m_reader->next(m_token))
+        {
+            m_reader = nullptr;
+        }
+
+        return *this;
+    }
+
+
+    /**
+     * @brief Return whether two iterators are equal. Only end-of-stream iterators are equal.
+     *
+     * @param other The other iterator.
+     *
+     * @return Whether both iterators are end-of-stream iterators.
+     */
+    bool operator==(const TokenIterator &other) const
+    {
+        return m_reader == other.m_reader;
+    }
+
+
+    /**
+     * @brief Return whether two iterators differ.
+     *
+     * @param other The other iterator.
+     *
+     * @return Whether the iterators differ.
+     */
+    bool operator!=(const TokenIterator &other) const
+    {
+        return !(*this == other);
+    }
+
+
+private:
+    /// The token reader, nullptr for the end-of-stream iterator
+    TokenReader *m_reader;
+
+    /// The current token
+    cmd::TokenView m_token;
+};
+
+
+inline TokenIterator TokenReader::begin()
+{
+    return TokenIterator(*this);
+}
+
+
+inline TokenIterator TokenReader::end()
+{
+    return TokenIterator();
+}
+
+
+template <typename T, typename Callback>
+/**
+ * @brief Read all remaining tokens, convert them to T and call a callback for each value.
+ *
+ * Tokens are converted with argument<T>::convert() through a single reused command line slot,
+ * so no memory is allocated per token once the slot is large enough.
+ *
+ * @tparam T The value type. argument::convert() must be implemented for T.
+ * @tparam Callback The callback type: void(const T &).
+ *
+ * @param reader The token reader.
+ * @param callback The callback.
+ *
+ * @return The number of values read.
+ * @throws #cppargparse::errors::StreamError if reading from the file descriptor fails.
+ * @throws #cppargparse::errors::CommandLineOptionError if a token cannot be converted to T.
+ */
+size_t for_each_value(TokenReader &reader, Callback callback)
+{
+    cmd::CommandLine_t slot(1);
+    const cmd::CommandLineArguments_t cmdargs;
+
+    return reader.for_each([&](const cmd::TokenView &token)
+    {
+        slot.front().assign(token.data(), token.size());
+        callback(argument<T>::convert(slot, slot.cbegin(), cmdargs));
+    });
+}
+
+
+} // namespace stream
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_STREAM_H
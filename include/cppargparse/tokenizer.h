@@ -0,0 +1,406 @@
+#ifndef CPPARGPARSE_TOKENIZER_H
+#define CPPARGPARSE_TOKENIZER_H
+
+/**
+  @file cppargparse/tokenizer.h
+  @brief Splitting raw text into command line tokens.
+ */
+
+
+#include <string>
+#include <vector>
+
+#include <cppargparse/cmd.h>
+#include <cppargparse/errors.h>
+
+
+namespace cppargparse {
+namespace tokenizer {
+
+
+/**
+ * @brief Return whether a character separates two tokens.
+ *
+ * @param c The character.
+ *
+ * @return Whether @p c is whitespace or NUL.
+ */
+inline bool is_separator(const char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f' || c == '\0';
+}
+
+
+/**
+ * @brief Return whether a character starts quoting or escaping.
+ *
+ * @param c The character.
+ *
+ * @return Whether @p c is a quote or a backslash.
+ */
+inline bool is_special(const char c)
+{
+    return c == '\'' || c == '"' || c == '\\';
+}
+
+
+/**
+ * @brief Internal: Return the closing quote of a token consisting of exactly one quoted string.
+ *
+ * @param position The opening quote.
+ * @param last The end of the input.
+ *
+ * @return The closing quote or nullptr if the token needs unescaping.
+ */
+inline const char *find_plain_quoted(const char *position, const char *last)
+{
+    const char quote = *position;
+
+    for (const char *current = position + 1; current != last; ++current)
+    {
+        if (*current == quote)
+        {
+            return (current + 1 == last || is_separator(current[1])) ? current : nullptr;
+        }
+
+        if (quote == '"' && *current == '\\')
+        {
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+
+template <typename Callback>
+/**
+ * @brief Split raw text into tokens and call a callback for each of them.
+ *
+ * Tokens are separated by whitespace or NUL characters. Single quotes preserve their contents literally,
+ * double quotes and unquoted text honor backslash escapes.
+ *
+ * Tokens without quoting are passed as views into the input. Only tokens that need unescaping
+ * are copied, into a scratch buffer which is reused for the next such token.
+ *
+ * @tparam Callback The callback type: void(const cmd::TokenView &).
+ *
+ * @param first The first character of the input.
+ * @param last The end of the input.
+ * @param scratch The scratch buffer. Reusing it across calls avoids allocating once it has grown.
+ * @param callback The callback to call for each token. The view is only valid during the call.
+ * @param error Receives the error message if a quote isn't closed.
+ *
+ * @return Whether the whole input has been tokenized. On errors, the callback has seen the tokens before.
+ */
+bool try_for_each_token(const char *first, const char *last, std::string &scratch, Callback callback, std::string &error)
+{
+    const char *position = first;
+
+    while (position != last)
+    {
+        if (is_separator(*position))
+        {
+            ++position;
+            continue;
+        }
+
+        // Fast path: plain token
+        const char *start = position;
+
+        while (position != last && !is_separator(*position) && !is_special(*position))
+        {
+            ++position;
+        }
+
+        if (position == last || is_separator(*position))
+        {
+            callback(cmd::TokenView(start, static_cast<size_t>(position - start)));
+            continue;
+        }
+
+        // Fast path: the whole token is a quoted string without escapes
+        if (position == start && *position != '\\')
+        {
+            const char *closing = find_plain_quoted(position, last);
+
+            if (closing)
+            {
+                callback(cmd::TokenView(start + 1, static_cast<size_t>(closing - start - 1)));
+                position = closing + 1;
+                continue;
+            }
+        }
+
+        // Slow path: unescape into the scratch buffer
+        scratch.assign(start, position);
+
+        while (position != last && !is_separator(*position))
+        {
+            const char c = *position++;
+
+            if (c == '\'')
+            {
+                const char *closing = position;
+
+                while (closing != last && *closing != '\'')
+                {
+                    ++closing;
+                }
+
+                if (closing == last)
+                {
+                    error = "Missing closing quote (') for token at offset " + std::to_string(start - first);
+                    return false;
+                }
+
+                scratch.append(position, closing);
+                position = closing + 1;
+            }
+            else if (c == '"')
+            {
+                while (position != last && *position != '"')
+                {
+                    if (*position == '\\' && position + 1 != last &&
+                            (position[1] == '"' || position[1] == '\\' || position[1] == '$' ||
+                             position[1] == '`' || position[1] == '\n'))
+                    {
+                        ++position;
+
+                        if (*position == '\n')
+                        {
+                            ++position;
+                            continue;
+                        }
+                    }
+
+                    scratch.push_back(*position++);
+                }
+
+                if (position == last)
+                {
+                    error = "Missing closing quote (\") for token at offset " + std::to_string(start - first);
+                    return false;
+                }
+
+                ++position;
+            }
+            else if (c == '\\')
+            {
+                if (position == last)
+                {
+                    scratch.push_back(c);
+                }
+                else if (*position == '\n')
+                {
+                    ++position;
+                }
+                else
+                {
+                    scratch.push_back(*position++);
+                }
+            }
+            else
+            {
+                scratch.push_back(c);
+            }
+        }
+
+        callback(cmd::TokenView(scratch));
+    }
+
+    return true;
+}
+
+
+template <typename Callback>
+/**
+ * @brief Split raw text into tokens and call a callback for each of them, see try_for_each_token().
+ *
+ * @tparam Callback The callback type: void(const cmd::TokenView &).
+ *
+ * @param first The first character of the input.
+ * @param last The end of the input.
+ * @param scratch The scratch buffer. Reusing it across calls avoids allocating once it has grown.
+ * @param callback The callback to call for each token. The view is only valid during the call.
+ *
+ * @throws #cppargparse::errors::TokenizerError if a quote isn't closed.
+ */
+void for_each_token(const char *first, const char *last, std::string &scratch, Callback callback)
+{
+    std::string error;
+
+    if (!try_for_each_token(first, last, scratch, callback, error))
+    {
+        errors::raise<errors::TokenizerError>(error);
+    }
+}
+
+
+template <typename Callback>
+/**
+ * @brief Split raw text into tokens and call a callback for each of them.
+ *
+ * @tparam Callback The callback type: void(const cmd::TokenView &).
+ *
+ * @param first The first character of the input.
+ * @param last The end of the input.
+ * @param callback The callback to call for each token. The view is only valid during the call.
+ *
+ * @throws #cppargparse::errors::TokenizerError if a quote isn't closed.
+ */
+void for_each_token(const char *first, const char *last, Callback callback)
+{
+    std::string scratch;
+    for_each_token(first, last, scratch, callback);
+}
+
+
+/**
+ * @brief Split raw text into a command line.
+ *
+ * @param text The text.
+ *
+ * @return The tokens, copied.
+ * @throws #cppargparse::errors::TokenizerError if a quote isn't closed.
+ */
+inline cmd::CommandLine_t split(const cmd::TokenView &text)
+{
+    cmd::CommandLine_t cmd;
+
+    for_each_token(text.data(), text.data() + text.size(), [&cmd](const cmd::TokenView &token)
+    {
+        cmd.emplace_back(token.data(), token.size());
+    });
+
+    return cmd;
+}
+
+
+/**
+ * @brief The tokens of one line of text, kept for as long as the line.
+ *
+ * Plain and simply quoted tokens are views into the line. Tokens that need unescaping are copied into
+ * one buffer owned by the holder, which is reserved up front, since unescaping never makes a token longer.
+ * Assigning the next line reuses all memory, so a loop reading lines stops allocating once it has seen
+ * its longest line.
+ *
+ * Example:
+ * @code
+ * tokenizer::Tokens tokens;
+ *
+ * while (std::getline(std::cin, line))
+ * {
+ *     tokens.assign(line);
+ *     ...
+ * }
+ * @endcode
+ */
+class Tokens
+{
+public:
+    /**
+     * @brief c'tor
+     */
+    Tokens()
+        : m_views()
+        , m_unescaped()
+        , m_scratch()
+    {
+    }
+
+
+    Tokens(const Tokens &) = delete;
+    Tokens &operator=(const Tokens &) = delete;
+
+
+    /**
+     * @brief Split a line into tokens, replacing the previous ones.
+     *
+     * @param line The line. Must outlive the tokens.
+     *
+     * @throws #cppargparse::errors::TokenizerError if a quote isn't closed.
+     */
+    void assign(const cmd::TokenView &line)
+    {
+        m_views.clear();
+        m_unescaped.clear();
+        m_unescaped.reserve(line.size());
+
+        for_each_token(line.data(), line.data() + line.size(), m_scratch, [this](const cmd::TokenView &token)
+        {
+            if (token.data() != m_scratch.data())
+            {
+                m_views.emplace_back(token);
+                return;
+            }
+
+            const size_t offset = m_unescaped.size();
+            m_unescaped.append(token.data(), token.size());
+            m_views.emplace_back(m_unescaped.data() + offset, token.size());
+        });
+    }
+
+
+    /**
+     * @brief Return the number of tokens.
+     *
+     * @return The number of tokens.
+     */
+    size_t size() const
+    {
+        return m_views.size();
+    }
+
+
+    /**
+     * @brief Return a token.
+     *
+     * @param index The token index. Must be less than size().
+     *
+     * @return The token.
+     */
+    const cmd::TokenView &operator[](const size_t index) const
+    {
+        return m_views[index];
+    }
+
+
+    /**
+     * @brief Return an iterator to the first token.
+     *
+     * @return An iterator to the first token.
+     */
+    std::vector<cmd::TokenView>::const_iterator begin() const
+    {
+        return m_views.cbegin();
+    }
+
+
+    /**
+     * @brief Return an iterator past the last token.
+     *
+     * @return An iterator past the last token.
+     */
+    std::vector<cmd::TokenView>::const_iterator end() const
+    {
+        return m_views.cend();
+    }
+
+
+private:
+    /// The tokens
+    std::vector<cmd::TokenView> m_views;
+
+    /// The unescaped tokens, back to back
+    std::string m_unescaped;
+
+    /// The tokenizer's scratch buffer
+    std::string m_scratch;
+};
+
+
+} // namespace tokenizer
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_TOKENIZER_H
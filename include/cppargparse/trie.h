@@ -0,0 +1,208 @@
+#ifndef CPPARGPARSE_TRIE_H
+#define CPPARGPARSE_TRIE_H
+
+/**
+  @file cppargparse/trie.h
+  @brief Resolving unique prefixes of option IDs.
+ */
+
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <cppargparse/cmd.h>
+
+
+namespace cppargparse {
+namespace trie {
+
+
+/**
+ * @brief Index value for "no option".
+ */
+constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+
+/**
+ * @brief A compressed radix trie over strings stored back to back in one buffer.
+ *
+ * Edge labels are offsets into the buffer, nothing is copied. Every node knows whether all strings
+ * below it belong to the same option, so resolving a unique prefix walks the prefix once and stops.
+ */
+class Trie
+{
+public:
+    /**
+     * @brief c'tor
+     *
+     * Creates a trie holding only the root.
+     */
+    Trie()
+        : m_nodes(1, Node {0, 0, npos, npos, npos, npos})
+    {
+    }
+
+
+    /**
+     * @brief Add a string.
+     *
+     * @param chars The buffer. Must outlive the trie and must not change.
+     * @param offset The string offset inside @p chars.
+     * @param size The string size.
+     * @param option The option index of the string.
+     */
+    void insert(const std::string &chars, const size_t offset, const size_t size, const size_t option)
+    {
+        size_t node = 0;
+        size_t depth = 0;
+
+        while (depth < size)
+        {
+            const size_t child = find_child(chars, node, chars[offset + depth]);
+
+            if (child == npos)
+            {
+                m_nodes.push_back(Node {offset + depth, size - depth, option, option, npos, m_nodes[node].child});
+                m_nodes[node].child = m_nodes.size() - 1;
+                return;
+            }
+
+            const size_t common = common_size(chars, m_nodes[child], chars.data() + offset + depth, size - depth);
+
+            if (common < m_nodes[child].size)
+            {
+                // Split the edge: the child keeps the common part, a new node takes the rest
+                const Node split = m_nodes[child];
+                m_nodes.push_back(Node {split.offset + common, split.size - common, split.option, split.unique, split.child, npos});
+
+                m_nodes[child].size = common;
+                m_nodes[child].option = npos;
+                m_nodes[child].child = m_nodes.size() - 1;
+            }
+
+            if (m_nodes[child].unique != option)
+            {
+                m_nodes[child].unique = npos;
+            }
+
+            node = child;
+            depth += common;
+        }
+
+        m_nodes[node].option = option;
+    }
+
+
+    /**
+     * @brief Return the option all strings starting with a prefix belong to.
+     *
+     * @param chars The buffer the strings have been added from.
+     * @param prefix The prefix.
+     * @param found Receives whether any string starts with @p prefix.
+     *
+     * @return The option index, or #npos if no string or strings of several options start with @p prefix.
+     */
+    size_t find_prefix(const std::string &chars, const cmd::TokenView &prefix, bool &found) const
+    {
+        size_t node = 0;
+        size_t depth = 0;
+
+        found = false;
+
+        while (depth < prefix.size())
+        {
+            node = find_child(chars, node, prefix[depth]);
+
+            if (node == npos)
+            {
+                return npos;
+            }
+
+            const size_t rest = prefix.size() - depth;
+            const size_t common = common_size(chars, m_nodes[node], prefix.data() + depth, rest);
+
+            if (common < std::min(m_nodes[node].size, rest))
+            {
+                return npos;
+            }
+
+            depth += common;
+        }
+
+        found = (node != 0);
+
+        return found ? m_nodes[node].unique : npos;
+    }
+
+
+private:
+    /**
+     * @brief Internal: A trie node and the edge leading to it.
+     */
+    struct Node
+    {
+        /// The edge label offset inside the buffer
+        size_t offset;
+
+        /// The edge label size
+        size_t size;
+
+        /// The option of the string ending here or npos
+        size_t option;
+
+        /// The option of all strings below, npos if there are several
+        size_t unique;
+
+        /// The first child or npos
+        size_t child;
+
+        /// The next sibling or npos
+        size_t sibling;
+    };
+
+
+    /**
+     * @brief Internal: Return the child whose edge starts with a character.
+     */
+    size_t find_child(const std::string &chars, const size_t node, const char c) const
+    {
+        size_t child = m_nodes[node].child;
+
+        while (child != npos && chars[m_nodes[child].offset] != c)
+        {
+            child = m_nodes[child].sibling;
+        }
+
+        return child;
+    }
+
+
+    /**
+     * @brief Internal: Return the size of the common prefix of an edge label and a string.
+     */
+    static size_t common_size(const std::string &chars, const Node &node, const char *data, const size_t size)
+    {
+        const size_t limit = std::min(node.size, size);
+        size_t common = 0;
+
+        while (common < limit && chars[node.offset + common] == data[common])
+        {
+            ++common;
+        }
+
+        return common;
+    }
+
+
+    /// The nodes, the root first
+    std::vector<Node> m_nodes;
+};
+
+
+} // namespace trie
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_TRIE_H
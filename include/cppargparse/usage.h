@@ -0,0 +1,288 @@
+#ifndef CPPARGPARSE_USAGE_H
+#define CPPARGPARSE_USAGE_H
+
+/**
+  @file cppargparse/usage.h
+  @brief Rendering the usage text into a single preallocated buffer.
+ */
+
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <cppargparse/cmd.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#define CPPARGPARSE_WRITE ::_write
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#define CPPARGPARSE_WRITE ::write
+#endif
+
+
+namespace cppargparse {
+namespace usage {
+
+
+/**
+ * @brief The number of spaces between the argument IDs and the description column.
+ */
+constexpr size_t column_gap = 3;
+
+
+/**
+ * @brief Descriptions are not wrapped if fewer than this many columns are left for them.
+ */
+constexpr size_t min_description_width = 20;
+
+
+/**
+ * @brief Return the width of the terminal behind a file descriptor.
+ *
+ * Falls back to the COLUMNS environment variable.
+ *
+ * @param fd The file descriptor.
+ *
+ * @return The terminal width or 0 if it is unknown, e.g. if @p fd isn't a terminal.
+ */
+inline size_t terminal_width(const int fd)
+{
+#if defined(TIOCGWINSZ)
+    struct winsize size;
+
+    if (::ioctl(fd, TIOCGWINSZ, &size) == 0 && size.ws_col > 0)
+    {
+        return size.ws_col;
+    }
+#else
+    (void) fd;
+#endif
+
+    const char *columns = std::getenv("COLUMNS");
+
+    return columns ? std::strtoul(columns, nullptr, 10) : 0;
+}
+
+
+template <typename Callback>
+/**
+ * @brief Internal: Split a description into lines of at most @p width characters.
+ *
+ * Lines break at the last space which fits, words longer than @p width are split.
+ * Spaces at line breaks are dropped.
+ *
+ * @tparam Callback void(const char *first, const char *last)
+ *
+ * @param first The start of the description.
+ * @param last The end of the description.
+ * @param width The maximum line width, 0 to disable wrapping.
+ * @param callback Called once per line.
+ */
+inline void for_each_line(const char *first, const char *last, const size_t width, Callback callback)
+{
+    if (width == 0 || static_cast<size_t>(last - first) <= width)
+    {
+        callback(first, last);
+        return;
+    }
+
+    while (first != last)
+    {
+        if (static_cast<size_t>(last - first) <= width)
+        {
+            callback(first, last);
+            return;
+        }
+
+        const char *end = first + width;
+        const char *space = end;
+
+        while (space != first && *space != ' ')
+        {
+            --space;
+        }
+
+        if (space != first)
+        {
+            end = space;
+        }
+
+        callback(first, end);
+
+        first = end;
+
+        while (first != last && *first == ' ')
+        {
+            ++first;
+        }
+    }
+}
+
+
+/**
+ * @brief Render the usage text.
+ *
+ * The exact size is computed up front, so the text is written into a single allocation.
+ * Descriptions start in a common column and are wrapped to @p width, continuation lines are indented to that column.
+ *
+ * Example:
+ * @code
+ * Usage: app -- does things
+ *
+ *   -h|--help       Display this information
+ *   -t|--threads    The number of worker threads
+ * @endcode
+ *
+ * @param description The application description.
+ * @param cmdargs The command line arguments.
+ * @param width The line width to wrap descriptions at, 0 to disable wrapping.
+ *
+ * @return The usage text.
+ */
+inline std::string render(const std::string &description, const cmd::CommandLineArguments_t &cmdargs, const size_t width)
+{
+    static const char header[] = "Usage: ";
+    static const size_t header_size = sizeof(header) - 1;
+
+    // The description column: two spaces, "id|id_alt", the gap
+    size_t column = 0;
+
+    for (const auto &cmdarg : cmdargs)
+    {
+        const size_t id_length = cmdarg.id().size() + (cmdarg.id_alt().empty() ? 0 : cmdarg.id_alt().size() + 1);
+
+        if (id_length > column)
+        {
+            column = id_length;
+        }
+    }
+
+    column += 2 + column_gap;
+
+    const size_t line_width = (width >= column + min_description_width) ? width - column : 0;
+
+    // Pass 1: the exact size
+    size_t size = header_size + description.size() + 2;
+
+    for (const auto &cmdarg : cmdargs)
+    {
+        const std::string &text = cmdarg.description();
+
+        if (text.empty())
+        {
+            size += 2 + cmdarg.id().size() + (cmdarg.id_alt().empty() ? 0 : cmdarg.id_alt().size() + 1) + 1;
+            continue;
+        }
+
+        size_t lines = 0;
+        size_t characters = 0;
+
+        for_each_line(text.data(), text.data() + text.size(), line_width, [&](const char *first, const char *last)
+        {
+            ++lines;
+            characters += static_cast<size_t>(last - first);
+        });
+
+        size += lines * (column + 1) + characters;
+    }
+
+    // Pass 2: fill the buffer
+    std::string usage(size, '\0');
+    char *out = &usage[0];
+
+    const auto append = [&out](const char *data, const size_t count)
+    {
+        std::memcpy(out, data, count);
+        out += count;
+    };
+
+    const auto pad = [&out](const size_t count)
+    {
+        std::memset(out, ' ', count);
+        out += count;
+    };
+
+    append(header, header_size);
+    append(description.data(), description.size());
+    append("\n\n", 2);
+
+    for (const auto &cmdarg : cmdargs)
+    {
+        const std::string &text = cmdarg.description();
+        size_t id_length = cmdarg.id().size();
+
+        pad(2);
+        append(cmdarg.id().data(), cmdarg.id().size());
+
+        if (!cmdarg.id_alt().empty())
+        {
+            append("|", 1);
+            append(cmdarg.id_alt().data(), cmdarg.id_alt().size());
+            id_length += cmdarg.id_alt().size() + 1;
+        }
+
+        if (text.empty())
+        {
+            append("\n", 1);
+            continue;
+        }
+
+        size_t indent = column - 2 - id_length;
+
+        for_each_line(text.data(), text.data() + text.size(), line_width, [&](const char *first, const char *last)
+        {
+            pad(indent);
+            append(first, static_cast<size_t>(last - first));
+            append("\n", 1);
+
+            indent = column;
+        });
+    }
+
+    return usage;
+}
+
+
+/**
+ * @brief Write a text to a file descriptor.
+ *
+ * Partial writes and interruptions are retried.
+ *
+ * @param fd The file descriptor. Not closed.
+ * @param text The text.
+ *
+ * @return Whether the whole text has been written.
+ */
+inline bool write(const int fd, const std::string &text)
+{
+    size_t written = 0;
+
+    while (written < text.size())
+    {
+        const auto count = CPPARGPARSE_WRITE(fd, text.data() + written, static_cast<unsigned int>(text.size() - written));
+
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+
+        if (count <= 0)
+        {
+            return false;
+        }
+
+        written += static_cast<size_t>(count);
+    }
+
+    return true;
+}
+
+
+} // namespace usage
+} // namespace cppargparse
+
+#endif // CPPARGPARSE_USAGE_H
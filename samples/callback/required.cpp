@@ -18,9 +18,10 @@ void add_five(const cppargparse::parser::ArgumentParser &, int value)
 }
 
 
-void parse_xml(const cppargparse::parser::ArgumentParser &, const std::string &filename)
+void parse_xml(const cppargparse::parser::ArgumentParser &, const cppargparse::io::PrefetchedPath &filename)
 {
-    std::cout << "Parsing XML: " << filename << '\n';
+    // The kernel has been advised to read the file ahead, which it does while the program continues
+    std::cout << "Parsing XML: " << filename.str() << " (prefetched: " << filename.prefetched() << ")" << '\n';
 
     // parse the XML file here
 }
@@ -50,7 +51,7 @@ int main(int argc, char *argv[])
         &add_five
     );
 
-    arg_parser.add_arg_with_callback<std::string>(
+    arg_parser.add_arg_with_callback<io::PrefetchedPath>(
         "-x", "--xml",
         "Parse an XML file",
         &parse_xml
@@ -1,3 +1,5 @@
+#include <cstdio>
+#include <fstream>
 #include <functional>
 #include <limits>
 #include <sstream>
@@ -497,3 +499,117 @@ TEST(TestArguments, StringsVectorReachEnd)
 {
     vector_test<std::string>(std::vector<std::string> {"THIS", "IS", "SAMPLE", "TEXT"}, true, false);
 }
+
+
+//
+// std::vector<T> into caller-provided storage
+//
+TEST(TestArguments, VectorIntoOutputIterator)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--seq 3 2 34 -t 3"), "TestArguments");
+
+    const auto seq = arg_parser.add_arg("-s", "--seq");
+    arg_parser.add_arg("-t");
+
+    std::vector<int> values {1};
+    const fill_result result = arg_parser.get_option_into<int>(seq, std::back_inserter(values));
+
+    ASSERT_EQ(size_t(3), result.written);
+    ASSERT_FALSE(result.truncated);
+    ASSERT_EQ((std::vector<int> {1, 3, 2, 34}), values);
+}
+
+TEST(TestArguments, VectorIntoBuffer)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--seq 3 2 34 6"), "TestArguments");
+
+    const auto seq = arg_parser.add_arg("-s", "--seq");
+
+    long buffer[8] = {0};
+    const fill_result result = arg_parser.get_option_into(seq, buffer, 8);
+
+    ASSERT_EQ(size_t(4), result.written);
+    ASSERT_FALSE(result.truncated);
+    ASSERT_EQ(34l, buffer[2]);
+    ASSERT_EQ(0l, buffer[4]);
+}
+
+TEST(TestArguments, VectorIntoArrayTruncated)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--seq 3 2 34 6"), "TestArguments");
+
+    const auto seq = arg_parser.add_arg("-s", "--seq");
+    const auto x = arg_parser.add_arg("-x");
+
+    int buffer[2] = {0, 0};
+    const fill_result result = arg_parser.get_option_into<int>(seq, buffer);
+
+    ASSERT_EQ(size_t(2), result.written);
+    ASSERT_TRUE(result.truncated);
+    ASSERT_EQ(3, buffer[0]);
+    ASSERT_EQ(2, buffer[1]);
+
+    ASSERT_THROW(arg_parser.get_option_into<int>(x, buffer), errors::CommandLineArgumentError);
+}
+
+
+//
+// io::Path, io::PrefetchedPath
+//
+TEST(TestArguments, Path)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--xml /tmp/data.xml -o"), "TestArguments");
+
+    const auto xml = arg_parser.add_arg("-x", "--xml");
+    const auto o = arg_parser.add_arg("-o");
+
+    ASSERT_EQ("/tmp/data.xml", arg_parser.get_option<io::Path>(xml).str());
+    ASSERT_THROW(arg_parser.get_option<io::Path>(o), errors::CommandLineOptionError);
+}
+
+TEST(TestArguments, PrefetchedPath)
+{
+    using namespace cppargparse;
+
+    {
+        std::ofstream file("test_arguments_prefetch.xml");
+        file << "<xml/>";
+    }
+
+    auto arg_parser = test::make_arg_parser(
+                test::parse_cmdargs("--xml test_arguments_prefetch.xml --missing test_arguments_missing.xml"),
+                "TestArguments");
+
+    const auto xml = arg_parser.add_arg("-x", "--xml");
+    const auto missing = arg_parser.add_arg("--missing");
+
+    const io::PrefetchedPath path = arg_parser.get_option<io::PrefetchedPath>(xml);
+    ASSERT_EQ("test_arguments_prefetch.xml", path.str());
+    ASSERT_NE(io::PrefetchedPath::Status::Failed, path.status());
+
+    // Reading the file brings all of its pages into the page cache
+    {
+        std::ifstream file("test_arguments_prefetch.xml");
+        std::string content;
+        std::getline(file, content);
+        ASSERT_EQ("<xml/>", content);
+    }
+
+    ASSERT_EQ(io::PrefetchedPath::Status::Complete, path.status());
+    ASSERT_TRUE(path.prefetched());
+
+    // Converting the path again while the cached value exists shares its advised file
+    auto other_parser = test::make_arg_parser(test::parse_cmdargs("--xml test_arguments_prefetch.xml"), "TestArguments");
+    const io::PrefetchedPath again = other_parser.get_option<io::PrefetchedPath>(other_parser.add_arg("--xml"));
+    ASSERT_EQ(io::PrefetchedPath::Status::Complete, again.status());
+
+    const io::PrefetchedPath missing_path = arg_parser.get_option<io::PrefetchedPath>(missing);
+    ASSERT_EQ(io::PrefetchedPath::Status::Failed, missing_path.status());
+    ASSERT_FALSE(missing_path.prefetched());
+
+    std::remove("test_arguments_prefetch.xml");
+}
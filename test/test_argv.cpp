@@ -0,0 +1,115 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/argv.h>
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// to_chars(<arithmetic>)
+//
+TEST(TestArgv, ToChars)
+{
+    using namespace cppargparse;
+
+    char buffer[argv::max_chars];
+    const auto format = [&buffer](char *end)
+    {
+        return std::string(buffer, end);
+    };
+
+    ASSERT_EQ("0", format(argv::to_chars(buffer, buffer + sizeof(buffer), 0)));
+    ASSERT_EQ("-2147483648", format(argv::to_chars(buffer, buffer + sizeof(buffer), -2147483647 - 1)));
+    ASSERT_EQ("18446744073709551615", format(argv::to_chars(buffer, buffer + sizeof(buffer), 18446744073709551615ull)));
+    ASSERT_EQ("0.5", format(argv::to_chars(buffer, buffer + sizeof(buffer), 0.5)));
+    ASSERT_EQ("true", format(argv::to_chars(buffer, buffer + sizeof(buffer), true)));
+    ASSERT_EQ("x", format(argv::to_chars(buffer, buffer + sizeof(buffer), 'x')));
+
+    ASSERT_EQ("0.1", format(argv::to_chars(buffer, buffer + sizeof(buffer), 0.1)));
+    ASSERT_EQ("0.1", format(argv::to_chars(buffer, buffer + sizeof(buffer), 0.1f)));
+    ASSERT_EQ("0.30000000000000004", format(argv::to_chars(buffer, buffer + sizeof(buffer), 0.1 + 0.2)));
+    ASSERT_EQ(1.0 / 3, std::stod(format(argv::to_chars(buffer, buffer + sizeof(buffer), 1.0 / 3))));
+    ASSERT_EQ(nullptr, argv::to_chars(buffer, buffer + 2, 123));
+}
+
+
+//
+// Builder::forward() + Builder::option() + Builder::build()
+//
+TEST(TestArgv, Build)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 --hosts a b -v --timeout 5"), "TestArgv");
+
+    const auto threads = arg_parser.add_arg("-t", "--threads");
+    const auto hosts = arg_parser.add_arg("--hosts");
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+    const auto quiet = arg_parser.add_arg("-q", "--quiet");
+    const auto timeout = arg_parser.add_arg("--timeout");
+    const auto missing = arg_parser.add_arg("--missing");
+
+    argv::Builder builder;
+    builder.append("worker")
+        .forward(arg_parser, threads)
+        .forward(arg_parser, hosts)
+        .forward(arg_parser, missing)
+        .forward_flag(arg_parser, verbose)
+        .forward_flag(arg_parser, quiet)
+        .option(timeout, arg_parser.get_option<int>(timeout) * 2)
+        .option(hosts, std::vector<int> {1, 2});
+
+    const argv::Argv argv = builder.build();
+
+    const std::vector<std::string> expected {
+        "worker", "-t", "4", "--hosts", "a", "b", "-v", "--timeout", "10", "--hosts", "1", "2"
+    };
+
+    ASSERT_EQ(expected.size(), argv.size());
+    ASSERT_EQ(nullptr, argv.data()[argv.size()]);
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_STREQ(expected[i].c_str(), argv[i]);
+    }
+}
+
+
+//
+// Argv copies + Argv::stamp()
+//
+TEST(TestArgv, Stamp)
+{
+    using namespace cppargparse;
+
+    argv::Builder builder;
+    builder.append("worker").append("--id").append(0).append("--name").append("template");
+
+    const argv::Argv tmpl = builder.build();
+
+    // Copies don't point into the template
+    const argv::Argv copy(tmpl);
+    ASSERT_STREQ("template", copy[4]);
+    ASSERT_NE(tmpl[4], copy[4]);
+
+    const argv::Argv child = tmpl.stamp(2, 12345);
+    ASSERT_EQ(size_t(5), child.size());
+    ASSERT_STREQ("worker", child[0]);
+    ASSERT_STREQ("12345", child[2]);
+    ASSERT_STREQ("--name", child[3]);
+    ASSERT_STREQ("template", child[4]);
+    ASSERT_EQ(nullptr, child.data()[5]);
+
+    const argv::Argv renamed = tmpl.stamp({{4, "a"}, {0, "other-worker"}});
+    ASSERT_STREQ("other-worker", renamed[0]);
+    ASSERT_STREQ("0", renamed[2]);
+    ASSERT_STREQ("a", renamed[4]);
+
+    // The template is unchanged
+    ASSERT_STREQ("0", tmpl[2]);
+    ASSERT_THROW(tmpl.stamp(5, "x"), std::out_of_range);
+}
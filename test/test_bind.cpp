@@ -0,0 +1,110 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+// The user struct the options are bound to
+struct Config
+{
+    int threads;
+    std::string name;
+    std::vector<double> weights;
+    bool verbose;
+    long limit;
+};
+
+
+// The binding table, built at compile time
+constexpr auto binding = cppargparse::bind::make_binding<Config>(
+        cppargparse::bind::option("-t", "--threads", &Config::threads, 4),
+        cppargparse::bind::option("-n", &Config::name, "unnamed"),
+        cppargparse::bind::option("-w", "--weights", &Config::weights),
+        cppargparse::bind::flag("-v", "--verbose", &Config::verbose),
+        cppargparse::bind::option("-l", &Config::limit));
+
+
+//
+// parse(): values are written into the bound fields
+//
+TEST(TestBind, Parse)
+{
+    using namespace cppargparse;
+
+    Config config;
+    config.limit = 7;
+
+    const char *argv[] = {"input", "--threads", "8", "-w", "0.5", "1.5", "-v", "-n", "name"};
+    binding.parse(9, argv, config);
+
+    ASSERT_EQ(8, config.threads);
+    ASSERT_EQ("name", config.name);
+    ASSERT_EQ((std::vector<double> {0.5, 1.5}), config.weights);
+    ASSERT_TRUE(config.verbose);
+    ASSERT_EQ(7, config.limit);
+}
+
+
+//
+// parse(): options which haven't been passed get their default values
+//
+TEST(TestBind, Defaults)
+{
+    using namespace cppargparse;
+
+    Config config;
+    config.limit = 7;
+
+    binding.parse(cmd::CommandLine_t {"-l", "100"}, config);
+
+    ASSERT_EQ(4, config.threads);
+    ASSERT_EQ("unnamed", config.name);
+    ASSERT_TRUE(config.weights.empty());
+    ASSERT_FALSE(config.verbose);
+    ASSERT_EQ(100, config.limit);
+}
+
+
+//
+// parse(): missing and invalid values raise errors
+//
+TEST(TestBind, Errors)
+{
+    using namespace cppargparse;
+
+    Config config;
+
+    ASSERT_THROW(binding.parse((cmd::CommandLine_t {"-t", "abc"}), config), errors::CommandLineOptionError);
+    ASSERT_THROW(binding.parse((cmd::CommandLine_t {"-w", "1", "x"}), config), errors::CommandLineOptionError);
+    ASSERT_THROW(binding.parse((cmd::CommandLine_t {"-t", "-v"}), config), errors::CommandLineOptionError);
+    ASSERT_THROW(binding.parse((cmd::CommandLine_t {"-v", "-n"}), config), errors::CommandLineOptionError);
+
+    try
+    {
+        binding.parse((cmd::CommandLine_t {"-v", "-t", "abc"}), config);
+        FAIL();
+    }
+
+    catch (const errors::CommandLineOptionError &error)
+    {
+        ASSERT_EQ(errors::Code::InvalidValue, error.code());
+        ASSERT_EQ(size_t(2), error.position());
+        ASSERT_EQ(std::string("Error: Couldn't convert 'abc' to type <int>."), error.what());
+    }
+
+    try
+    {
+        binding.parse((cmd::CommandLine_t {"-t", "-v"}), config);
+        FAIL();
+    }
+
+    catch (const errors::CommandLineOptionError &error)
+    {
+        ASSERT_EQ(errors::Code::MissingValue, error.code());
+        ASSERT_EQ(size_t(0), error.position());
+    }
+}
@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+// Write a configuration file to the current working directory
+void write_file(const std::string &path, const std::string &contents)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+}
+
+
+//
+// ConfigFile::parse()
+//
+TEST(TestConfig, Parse)
+{
+    using namespace cppargparse;
+
+    const std::string text =
+        "# comment\n"
+        "threads = 8\n"
+        "name = \"My \\\"Name\\\"\"   # inline comment\n"
+        "files = [a.txt, 'b c.txt', \"d.txt\"]\n"
+        "verbose\n"
+        "\n"
+        "[server]\n"
+        "port=8080\r\n";
+
+    config::ConfigFile config;
+    config.parse(text.data(), text.data() + text.size());
+
+    ASSERT_EQ(size_t(5), config.size());
+    ASSERT_EQ((cmd::CommandLine_t {"threads", "8"}), *config.find("threads"));
+    ASSERT_EQ((cmd::CommandLine_t {"name", "My \"Name\""}), *config.find("name"));
+    ASSERT_EQ((cmd::CommandLine_t {"files", "a.txt", "b c.txt", "d.txt"}), *config.find("files"));
+    ASSERT_EQ((cmd::CommandLine_t {"verbose"}), *config.find("verbose"));
+    ASSERT_EQ((cmd::CommandLine_t {"server.port", "8080"}), *config.find("server.port"));
+    ASSERT_EQ(nullptr, config.find("port"));
+}
+
+
+//
+// ConfigFile::parse(<syntax errors>)
+//
+TEST(TestConfig, SyntaxErrors)
+{
+    using namespace cppargparse;
+
+    for (const std::string text : {"[section\n", "key value\n", "key = 'open\n", "key = [1, 2\n", "= 3\n",
+                                   "files = [a.txt # comment\n", "files = [a.txt, # comment ]\n"})
+    {
+        config::ConfigFile config;
+        ASSERT_THROW(config.parse(text.data(), text.data() + text.size()), errors::ConfigFileError);
+
+        std::string error;
+        ASSERT_FALSE(config.try_parse(text.data(), text.data() + text.size(), error));
+        ASSERT_EQ(0u, error.find("Configuration line 1: "));
+    }
+}
+
+
+//
+// ArgumentParser::load_config() precedence: command line > configuration file > default
+//
+TEST(TestConfig, Precedence)
+{
+    using namespace cppargparse;
+    write_file("test_config_precedence.ini", "threads = 8\ntimeout = 30\nseq = [1, 2, 3]\nverbose = yes\nquiet = off\n");
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--timeout 5"), "TestConfig");
+    arg_parser.load_config("test_config_precedence.ini");
+
+    const auto threads = arg_parser.add_arg("-t", "--threads");
+    const auto timeout = arg_parser.add_arg("--timeout");
+    const auto seq = arg_parser.add_arg("-s", "--seq");
+    const auto retries = arg_parser.add_arg("--retries");
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+    const auto quiet = arg_parser.add_arg("-q", "--quiet");
+
+    ASSERT_EQ(8, arg_parser.get_option<int>(threads));
+    ASSERT_EQ(5, arg_parser.get_option<int>(timeout));
+    ASSERT_EQ((std::vector<int> {1, 2, 3}), arg_parser.get_option<std::vector<int>>(seq));
+    ASSERT_EQ(3, arg_parser.get_option<int>(retries, 3));
+    ASSERT_THROW(arg_parser.get_option<int>(retries), errors::CommandLineArgumentError);
+    ASSERT_TRUE(arg_parser.get_flag(verbose));
+    ASSERT_FALSE(arg_parser.get_flag(quiet));
+
+    std::remove("test_config_precedence.ini");
+}
+
+
+//
+// ArgumentParser::load_config(<missing file>)
+//
+TEST(TestConfig, MissingFile)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 3"), "TestConfig");
+
+    ASSERT_THROW(arg_parser.load_config("test_config_missing.ini"), errors::ConfigFileError);
+}
@@ -0,0 +1,293 @@
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+#include <cppargparse/deferred.h>
+
+#include "test_common.h"
+
+
+//
+// Queue: every task runs once, prerequisites before their dependents
+//
+TEST(TestDispatch, Order)
+{
+    using namespace cppargparse;
+
+    dispatch::Queue queue;
+    std::mutex mutex;
+    std::vector<int> order;
+
+    std::vector<dispatch::Task_t> tasks;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        tasks.push_back(queue.push([&mutex, &order, i]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(i);
+        }));
+    }
+
+    // A chain through every 8th task
+    for (size_t i = 8; i < tasks.size(); i += 8)
+    {
+        queue.depend(tasks[i], tasks[i - 8]);
+    }
+
+    ASSERT_EQ(64u, queue.size());
+
+    queue.run(4);
+
+    ASSERT_EQ(0u, queue.size());
+    ASSERT_EQ(64u, order.size());
+
+    std::vector<size_t> position(64);
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        position[order[i]] = i;
+    }
+
+    for (size_t i = 8; i < tasks.size(); i += 8)
+    {
+        ASSERT_LT(position[i - 8], position[i]);
+    }
+}
+
+
+//
+// Queue: independent tasks run at the same time
+//
+TEST(TestDispatch, Concurrent)
+{
+    using namespace cppargparse;
+
+    dispatch::Queue queue;
+    std::atomic<int> waiting(0);
+    std::atomic<bool> met(false);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        queue.push([&waiting, &met]()
+        {
+            ++waiting;
+
+            // Both tasks must be running for either of them to finish
+            while (waiting.load() < 2)
+            {
+            }
+
+            met.store(true);
+        });
+    }
+
+    queue.run(2);
+
+    ASSERT_TRUE(met.load());
+}
+
+
+//
+// Queue: dependencies must point backwards
+//
+TEST(TestDispatch, InvalidDependency)
+{
+    using namespace cppargparse;
+
+    dispatch::Queue queue;
+    const auto first = queue.push([]() {});
+    const auto second = queue.push([]() {});
+
+    ASSERT_THROW(queue.depend(first, second), errors::Error);
+    ASSERT_THROW(queue.depend(first, first), errors::Error);
+    ASSERT_NO_THROW(queue.depend(second, dispatch::none));
+}
+
+
+//
+// Queue: the first failed task by queue order is reported, its dependents are skipped
+//
+TEST(TestDispatch, Errors)
+{
+    using namespace cppargparse;
+
+    for (int round = 0; round < 20; ++round)
+    {
+        dispatch::Queue queue;
+        std::atomic<int> ran(0);
+
+        const auto first = queue.push([]()
+        {
+            throw std::runtime_error("first");
+        });
+
+        const auto dependent = queue.push([&ran]()
+        {
+            ++ran;
+        });
+
+        queue.push([]()
+        {
+            throw std::runtime_error("second");
+        });
+
+        queue.push([&ran]()
+        {
+            ++ran;
+        });
+
+        queue.depend(dependent, first);
+
+        try
+        {
+            queue.run(3);
+            FAIL();
+        }
+
+        catch (const std::runtime_error &error)
+        {
+            ASSERT_EQ(std::string("first"), error.what());
+        }
+
+        ASSERT_EQ(1, ran.load());
+    }
+}
+
+
+//
+// Dispatcher: queued callbacks run on dispatch()
+//
+TEST(TestDispatch, Parser)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-v -t 4 -n name"), "TestDispatch");
+    deferred::Dispatcher dispatcher(arg_parser);
+
+    std::atomic<int> verbose(0);
+    std::atomic<int> threads(0);
+    std::string name;
+
+    const auto verbose_task = dispatcher.add_flag_with_callback("-v", [&verbose](const parser::ArgumentParser &)
+    {
+        ++verbose;
+    });
+
+    const auto threads_task = dispatcher.add_arg_with_callback<int>("-t", [&threads](const parser::ArgumentParser &, const int &value)
+    {
+        threads.store(value);
+    });
+
+    const auto name_task = dispatcher.add_arg_with_callback<std::string>("-n", [&name, &threads](const parser::ArgumentParser &, const std::string &value)
+    {
+        name = value + std::to_string(threads.load());
+    });
+
+    const auto missing_task = dispatcher.add_flag_with_callback("-x", [](const parser::ArgumentParser &)
+    {
+        FAIL();
+    });
+
+    ASSERT_NE(dispatch::none, verbose_task);
+    ASSERT_EQ(dispatch::none, missing_task);
+
+    dispatcher.add_dependency(name_task, threads_task);
+
+    ASSERT_EQ(0, verbose.load());
+    ASSERT_EQ(0, threads.load());
+
+    dispatcher.dispatch(2);
+
+    ASSERT_EQ(1, verbose.load());
+    ASSERT_EQ(4, threads.load());
+    ASSERT_EQ("name4", name);
+}
+
+
+//
+// ArgumentParser: callbacks run right away by default
+//
+TEST(TestDispatch, Immediate)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-v"), "TestDispatch");
+    int verbose = 0;
+
+    arg_parser.add_flag_with_callback("-v", [&verbose](const parser::ArgumentParser &)
+    {
+        ++verbose;
+    });
+
+    ASSERT_EQ(1, verbose);
+}
+
+
+//
+// Queue: tasks queued with a context receive the one passed to run_with(), queues holding tasks can't be copied
+//
+TEST(TestDispatch, Context)
+{
+    using namespace cppargparse;
+
+    dispatch::Queue queue;
+    std::atomic<int> sum(0);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        queue.push_with_context<int>([&sum](const int &context)
+        {
+            sum += context;
+        });
+    }
+
+    ASSERT_THROW(dispatch::Queue copy(queue), errors::Error);
+
+    const int context = 5;
+    queue.run_with(context, 2);
+
+    ASSERT_EQ(20, sum.load());
+    ASSERT_NO_THROW(dispatch::Queue copy(queue));
+}
+
+
+//
+// Dispatcher: concurrent callbacks read values and the usage through the parser
+//
+TEST(TestDispatch, ConcurrentReads)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-v -t 4 -n name"), "TestDispatch");
+
+    const auto threads = arg_parser.add_arg("-t", "--threads", "The number of threads");
+    const auto name = arg_parser.add_arg("-n", "--name", "The name");
+
+    deferred::Dispatcher dispatcher(arg_parser);
+    std::atomic<int> failures(0);
+
+    for (int i = 0; i < 32; ++i)
+    {
+        dispatcher.add_flag_with_callback("-v", [&failures, &threads, &name, i](const parser::ArgumentParser &parser)
+        {
+            if (parser.usage(static_cast<size_t>(40 + i % 4)).find("--threads") == std::string::npos
+                    || !parser.get_flag(threads)
+                    || parser.get_option<int>(threads) != 4
+                    || parser.get_option<std::string>(name) != "name"
+                    || parser.get<int>("-t") != 4)
+            {
+                ++failures;
+            }
+        });
+    }
+
+    dispatcher.dispatch(4);
+
+    ASSERT_EQ(0, failures.load());
+}
@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// Environment::find()
+//
+TEST(TestEnv, Find)
+{
+    using namespace cppargparse;
+    ::setenv("CPPARGPARSE_TEST_FIND", "a=b", 1);
+
+    env::Environment environment;
+
+    ASSERT_STREQ("a=b", environment.find("CPPARGPARSE_TEST_FIND"));
+    ASSERT_EQ(nullptr, environment.find("CPPARGPARSE_TEST_UNSET"));
+
+    // The index is a snapshot until reindex() is called
+    ::setenv("CPPARGPARSE_TEST_LATE", "1", 1);
+    ASSERT_EQ(nullptr, environment.find("CPPARGPARSE_TEST_LATE"));
+
+    environment.reindex();
+    ASSERT_STREQ("1", environment.find("CPPARGPARSE_TEST_LATE"));
+}
+
+
+//
+// ArgumentParser::add_env_fallback()
+//
+TEST(TestEnv, Fallback)
+{
+    using namespace cppargparse;
+    ::setenv("CPPARGPARSE_TEST_THREADS", "12", 1);
+    ::setenv("CPPARGPARSE_TEST_TIMEOUT", "60", 1);
+    ::setenv("CPPARGPARSE_TEST_VERBOSE", "true", 1);
+    ::setenv("CPPARGPARSE_TEST_BROKEN", "many", 1);
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--timeout 5"), "TestEnv");
+
+    const auto threads = arg_parser.add_arg("-t", "--threads");
+    const auto timeout = arg_parser.add_arg("--timeout");
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+    const auto broken = arg_parser.add_arg("-b", "--broken");
+    const auto retries = arg_parser.add_arg("--retries");
+
+    arg_parser.add_env_fallback(threads, "CPPARGPARSE_TEST_THREADS");
+    arg_parser.add_env_fallback(timeout, "CPPARGPARSE_TEST_TIMEOUT");
+    arg_parser.add_env_fallback(verbose, "CPPARGPARSE_TEST_VERBOSE");
+    arg_parser.add_env_fallback(broken, "CPPARGPARSE_TEST_BROKEN");
+    arg_parser.add_env_fallback(retries, "CPPARGPARSE_TEST_UNSET");
+
+    ASSERT_EQ(12, arg_parser.get_option<int>(threads));
+    ASSERT_EQ(5, arg_parser.get_option<int>(timeout));
+    ASSERT_TRUE(arg_parser.get_flag(verbose));
+    ASSERT_THROW(arg_parser.get_option<int>(broken), errors::CommandLineOptionError);
+    ASSERT_EQ(3, arg_parser.get_option<int>(retries, 3));
+
+    ASSERT_EQ(cmd::Source::Environment, arg_parser.get_source(threads));
+    ASSERT_EQ(cmd::Source::CommandLine, arg_parser.get_source(timeout));
+    ASSERT_EQ(cmd::Source::Default, arg_parser.get_source(retries));
+}
+
+
+//
+// Precedence: command line > environment > configuration file > default
+//
+TEST(TestEnv, Precedence)
+{
+    using namespace cppargparse;
+    ::setenv("CPPARGPARSE_TEST_LEVEL", "debug", 1);
+
+    {
+        std::ofstream file("test_env_precedence.ini");
+        file << "level = info\nname = file\n";
+    }
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-x"), "TestEnv");
+    arg_parser.load_config("test_env_precedence.ini");
+
+    const auto level = arg_parser.add_arg("--level");
+    const auto name = arg_parser.add_arg("--name");
+
+    arg_parser.add_env_fallback(level, "CPPARGPARSE_TEST_LEVEL");
+    arg_parser.add_env_fallback(name, "CPPARGPARSE_TEST_UNSET");
+
+    ASSERT_EQ("debug", arg_parser.get_option<std::string>(level));
+    ASSERT_EQ("file", arg_parser.get_option<std::string>(name));
+
+    ASSERT_EQ(cmd::Source::Environment, arg_parser.get_source(level));
+    ASSERT_EQ(cmd::Source::ConfigFile, arg_parser.get_source(name));
+
+    std::remove("test_env_precedence.ini");
+}
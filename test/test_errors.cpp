@@ -0,0 +1,105 @@
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// Conversion errors carry the error code and the position of the offending token
+//
+TEST(TestErrors, Payload)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 -x abc -r 99999999999 -c xy -s"), "TestErrors");
+
+    const auto invalid = arg_parser.add_arg("-x");
+    const auto range = arg_parser.add_arg("-r");
+    const auto character = arg_parser.add_arg("-c");
+    const auto string = arg_parser.add_arg("-s");
+
+    try
+    {
+        arg_parser.get_option<int>(invalid);
+        FAIL();
+    }
+    catch (const errors::CommandLineOptionError &error)
+    {
+        ASSERT_EQ(errors::Code::InvalidValue, error.code());
+        ASSERT_EQ(3u, error.position());
+        ASSERT_STREQ("Error: Couldn't convert 'abc' to type <int>.", error.what());
+    }
+
+    try
+    {
+        arg_parser.get_option<int>(range);
+        FAIL();
+    }
+    catch (const errors::CommandLineOptionError &error)
+    {
+        ASSERT_EQ(errors::Code::OutOfRange, error.code());
+        ASSERT_EQ(5u, error.position());
+        ASSERT_STREQ("Error: Couldn't convert '99999999999' to type <int>: out of range.", error.what());
+    }
+
+    try
+    {
+        arg_parser.get_option<char>(character);
+        FAIL();
+    }
+    catch (const errors::CommandLineOptionError &error)
+    {
+        ASSERT_EQ(errors::Code::InvalidValue, error.code());
+        ASSERT_STREQ("Error: Couldn't convert 'xy' to type <char>.", error.what());
+    }
+
+    try
+    {
+        arg_parser.get_option<std::string>(string);
+        FAIL();
+    }
+    catch (const errors::CommandLineOptionError &error)
+    {
+        ASSERT_EQ(errors::Code::MissingValue, error.code());
+        ASSERT_EQ(8u, error.position());
+        ASSERT_STREQ("Error: Missing value after '-s' to type <std::string>.", error.what());
+    }
+}
+
+
+//
+// Long tokens are cut in the message, which stays valid in copies of the error
+//
+TEST(TestErrors, Excerpt)
+{
+    using namespace cppargparse;
+
+    const std::string token(100, 'x');
+    const errors::CommandLineOptionError error(errors::Code::InvalidValue, 1, "double", token.data(), token.size());
+
+    const auto copy = error;
+    const std::string message = copy.what();
+
+    ASSERT_EQ("Error: Couldn't convert '" + std::string(32, 'x') + "...' to type <double>.", message);
+    ASSERT_EQ(copy.what(), copy.what());
+    ASSERT_STREQ(message.c_str(), error.what());
+}
+
+
+//
+// Errors with a message keep it
+//
+TEST(TestErrors, Message)
+{
+    using namespace cppargparse;
+
+    const errors::CommandLineArgumentError error("Cannot find argument: -m");
+
+    ASSERT_EQ(errors::Code::None, error.code());
+    ASSERT_EQ(errors::npos, error.position());
+    ASSERT_STREQ("Error: Cannot find argument: -m", error.what());
+}
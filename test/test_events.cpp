@@ -0,0 +1,113 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// Reader: every token is classified with its owning option
+//
+TEST(TestEvents, Reader)
+{
+    using namespace cppargparse;
+
+    schema::Schema schema;
+    const size_t threads = schema.add("-t", "--threads");
+    const size_t verbose = schema.add("-v");
+
+    const char *argv[] = {"input", "--threads", "4", "-v", "a", "b", "--", "-t", "c"};
+
+    events::Reader reader(schema, 9, argv);
+    events::Event event;
+
+    const events::Kind kinds[] = {
+        events::Kind::Positional, events::Kind::Option, events::Kind::Value, events::Kind::Option,
+        events::Kind::Value, events::Kind::Value, events::Kind::EndOfOptions, events::Kind::Positional,
+        events::Kind::Positional
+    };
+
+    const size_t options[] = {schema::npos, threads, threads, verbose, verbose, verbose, schema::npos, schema::npos, schema::npos};
+
+    for (size_t i = 0; i < 9; ++i)
+    {
+        ASSERT_TRUE(reader.next(event));
+        ASSERT_EQ(i, event.index);
+        ASSERT_EQ(std::string(argv[i]), event.token.str());
+        ASSERT_EQ(kinds[i], event.kind);
+        ASSERT_EQ(options[i], event.option);
+    }
+
+    ASSERT_FALSE(reader.next(event));
+}
+
+
+//
+// parse(): events are pushed in order, the schema is built from the parser's arguments
+//
+TEST(TestEvents, Parse)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-s 1 2 -x"), "TestEvents");
+    arg_parser.add_arg("-s", "--seq");
+    arg_parser.add_arg("-x");
+
+    const schema::Schema schema(arg_parser.args());
+    const char *argv[] = {"--seq", "1", "2", "-x"};
+
+    std::vector<std::string> values;
+
+    const size_t count = events::parse(schema, 4, argv, [&values](const events::Event &event)
+    {
+        if (event.kind == events::Kind::Value && event.option == 0)
+        {
+            values.push_back(event.token.str());
+        }
+    });
+
+    ASSERT_EQ(4u, count);
+    ASSERT_EQ((std::vector<std::string> {"1", "2"}), values);
+}
+
+
+//
+// Reader: bundled and attached tokens yield one event per segment
+//
+TEST(TestEvents, Segments)
+{
+    using namespace cppargparse;
+
+    schema::Schema schema;
+    const size_t verbose = schema.add("-v");
+    const size_t extract = schema.add("-x");
+    const size_t timeout = schema.add("-t", "--timeout");
+
+    const char *argv[] = {"-vx", "--timeout=5", "-t3", "--", "-vx"};
+
+    events::Reader reader(schema, 5, argv);
+    events::Event event;
+
+    const events::Kind kinds[] = {
+        events::Kind::Option, events::Kind::Option, events::Kind::Option, events::Kind::Value,
+        events::Kind::Option, events::Kind::Value, events::Kind::EndOfOptions, events::Kind::Positional
+    };
+
+    const char *tokens[] = {"-v", "x", "--timeout", "5", "-t", "3", "--", "-vx"};
+    const size_t indexes[] = {0, 0, 1, 1, 2, 2, 3, 4};
+    const size_t options[] = {verbose, extract, timeout, timeout, timeout, timeout, schema::npos, schema::npos};
+
+    for (size_t i = 0; i < 8; ++i)
+    {
+        ASSERT_TRUE(reader.next(event));
+        ASSERT_EQ(kinds[i], event.kind);
+        ASSERT_EQ(std::string(tokens[i]), event.token.str());
+        ASSERT_EQ(indexes[i], event.index);
+        ASSERT_EQ(options[i], event.option);
+    }
+
+    ASSERT_FALSE(reader.next(event));
+}
@@ -0,0 +1,94 @@
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+// Report an error and leave the process, as sinks must not return
+void exit_sink(const std::exception &error)
+{
+    std::fprintf(stderr, "sink: %s\n", error.what());
+    std::exit(3);
+}
+
+
+//
+// Built with -fno-exceptions: the non-throwing API works as usual
+//
+TEST(TestNoExceptions, TryGetOption)
+{
+    using namespace cppargparse;
+    ASSERT_EQ(0, CPPARGPARSE_EXCEPTIONS);
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 -x abc"), "TestNoExceptions");
+
+    const auto threads = arg_parser.add_arg("-t");
+    const auto invalid = arg_parser.add_arg("-x");
+    const auto missing = arg_parser.add_arg("-m");
+
+    ASSERT_EQ(4, arg_parser.get_option<int>(threads));
+    ASSERT_EQ(errors::Code::InvalidValue, arg_parser.try_get_option<int>(invalid).error());
+    ASSERT_EQ(7, arg_parser.get_option<int>(missing, 7));
+}
+
+
+//
+// Built with -fno-exceptions: errors of the throwing API go to the error sink
+//
+TEST(TestNoExceptions, Sink)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-x abc"), "TestNoExceptions");
+
+    const auto invalid = arg_parser.add_arg("-x");
+    const auto missing = arg_parser.add_arg("-m");
+
+    errors::set_sink(&exit_sink);
+
+    ASSERT_EXIT(arg_parser.get_option<int>(missing), ::testing::ExitedWithCode(3), "sink: Error: Cannot find argument: -m");
+    ASSERT_EXIT(arg_parser.get_option<int>(invalid), ::testing::ExitedWithCode(3), "sink: Error: Couldn't convert 'abc'");
+
+    errors::set_sink(nullptr);
+    ASSERT_DEATH(arg_parser.get_option<int>(missing), "Cannot find argument");
+}
+
+
+//
+// Built with -fno-exceptions: reloading a broken file reports the error instead of reaching the sink
+//
+TEST(TestNoExceptions, Reload)
+{
+    using namespace cppargparse;
+
+    {
+        std::ofstream file("test_no_exceptions.conf");
+        file << "rate = 10\n";
+    }
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(""), "TestNoExceptions");
+    const auto rate = arg_parser.add_arg("-r", "--rate");
+
+    reload::Reloadable settings("test_no_exceptions.conf", arg_parser.args());
+
+    {
+        std::ofstream file("test_no_exceptions.conf");
+        file << "rate = [\n";
+    }
+
+    errors::set_sink(&exit_sink);
+
+    ASSERT_FALSE(settings.reload());
+    ASSERT_EQ("Error: Configuration line 1: missing ']'", settings.error());
+    ASSERT_EQ(10, settings.get_option<int>(rate));
+
+    errors::set_sink(nullptr);
+    std::remove("test_no_exceptions.conf");
+}
@@ -367,3 +367,362 @@ TEST(TestParser, AddArgWithCallbackDefault3)
 
     arg_parser.add_arg_with_callback_default<int>("-t", "--time", "The time it takes for...", 4, &check_t_is_4);
 }
+
+
+//
+// get_option() caches converted values per argument and type
+//
+TEST(TestParser, GetOptionCache)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 --seq a b -x c -v"), "TestParser");
+
+    const auto threads = arg_parser.add_arg("-t");
+    const auto seq = arg_parser.add_arg("--seq");
+    const auto verbose = arg_parser.add_arg("-v");
+
+    const int &first = arg_parser.get_option<int>(threads);
+    ASSERT_EQ(size_t(1), arg_parser.m_cache.size());
+    ASSERT_EQ(&first, &arg_parser.get_option<int>(threads));
+    ASSERT_EQ(size_t(1), arg_parser.m_cache.size());
+    ASSERT_EQ(4, first);
+    ASSERT_EQ(4l, arg_parser.get_option<long>(threads));
+    ASSERT_EQ("4", arg_parser.get_option<std::string>(threads));
+    ASSERT_EQ(4, first);
+
+    // The defaulting and non-throwing overloads share the cache, errors aren't cached
+    ASSERT_EQ(4u, arg_parser.get_option<unsigned int>(threads, 8u));
+    ASSERT_EQ(4u, arg_parser.get_option_or<unsigned int>(threads, 8u));
+    ASSERT_EQ(4.0, arg_parser.try_get_option<double>(threads).value());
+    ASSERT_EQ(&first, &arg_parser.get_option<int>(threads));
+    ASSERT_NE(nullptr, arg_parser.m_cache.find<unsigned int>("-t"));
+    ASSERT_NE(nullptr, arg_parser.m_cache.find<double>("-t"));
+    ASSERT_EQ(0, arg_parser.get_option_or<int>(seq, 0));
+    ASSERT_EQ(nullptr, arg_parser.m_cache.find<int>("--seq"));
+
+    ASSERT_TRUE(arg_parser.get_flag(verbose));
+    ASSERT_TRUE(arg_parser.get_flag(verbose));
+
+    // Values end at the next known argument: adding one invalidates cached values
+    ASSERT_EQ((std::vector<std::string> {"a", "b", "-x", "c"}), arg_parser.get_option<std::vector<std::string>>(seq));
+
+    // Copies outlive the cache, references are invalidated by adding an argument
+    const std::string value = arg_parser.get_option<std::string>(threads);
+
+    arg_parser.add_arg("-x");
+    ASSERT_EQ(size_t(0), arg_parser.m_cache.size());
+    ASSERT_EQ((std::vector<std::string> {"a", "b"}), arg_parser.get_option<std::vector<std::string>>(seq));
+    ASSERT_EQ("4", value);
+}
+
+
+//
+// Cached values are replaced, not accumulated
+//
+TEST(TestParser, Cache)
+{
+    using namespace cppargparse;
+
+    cache::Cache values;
+    values.store<std::vector<int>>("--seq", std::vector<int> {1, 2});
+    values.store<std::vector<int>>("--seq", std::vector<int> {3});
+    values.store<int>("--seq", 5);
+
+    ASSERT_EQ(2u, values.size());
+    ASSERT_EQ(std::vector<int> {3}, *values.find<std::vector<int>>("--seq"));
+    ASSERT_EQ(5, *values.find<int>("--seq"));
+    ASSERT_EQ(nullptr, values.find<long>("--seq"));
+    ASSERT_EQ(nullptr, values.find<int>("-t"));
+
+    values.clear();
+    ASSERT_EQ(0u, values.size());
+}
+
+
+//
+// get_options() returns several values at once
+//
+TEST(TestParser, GetOptions)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 --seq 1 2 3 -n name -v"), "TestParser");
+
+    const auto threads = arg_parser.add_arg("-t");
+    const auto seq = arg_parser.add_arg("--seq");
+    const auto name = arg_parser.add_arg("-n");
+    arg_parser.add_arg("-v");
+
+    int threads_value;
+    std::vector<int> seq_value;
+    std::string name_value;
+
+    std::tie(threads_value, seq_value, name_value) = arg_parser.get_options<int, std::vector<int>, std::string>(threads, seq, name);
+
+    ASSERT_EQ(4, threads_value);
+    ASSERT_EQ((std::vector<int> {1, 2, 3}), seq_value);
+    ASSERT_EQ("name", name_value);
+}
+
+
+//
+// get_options() reports all errors together
+//
+TEST(TestParser, GetOptionsErrors)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 -x abc --seq 1 b"), "TestParser");
+
+    const auto threads = arg_parser.add_arg("-t");
+    const auto invalid = arg_parser.add_arg("-x");
+    const auto missing = arg_parser.add_arg("-m");
+    const auto seq = arg_parser.add_arg("--seq");
+
+    try
+    {
+        arg_parser.get_options<int, int, int, std::vector<int>>(threads, invalid, missing, seq);
+        FAIL();
+    }
+    catch (const errors::AggregateError &error)
+    {
+        ASSERT_EQ(3u, error.failures().size());
+
+        ASSERT_EQ("-x", error.failures()[0].id);
+        ASSERT_EQ(errors::Code::InvalidValue, error.failures()[0].code);
+        ASSERT_EQ(3u, error.failures()[0].position);
+
+        ASSERT_EQ("-m", error.failures()[1].id);
+        ASSERT_EQ(errors::Code::MissingArgument, error.failures()[1].code);
+        ASSERT_EQ(errors::npos, error.failures()[1].position);
+
+        ASSERT_EQ("--seq", error.failures()[2].id);
+        ASSERT_EQ(6u, error.failures()[2].position);
+
+        ASSERT_STREQ("Error: 3 invalid argument(s): -x: invalid value 'abc'; -m: missing argument; --seq: invalid value 'b'",
+                     error.what());
+    }
+}
+
+
+//
+// find_arg() and get() look arguments up by ID
+//
+TEST(TestParser, GetById)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--threads 4 -n name"), "TestParser");
+
+    arg_parser.add_arg("-t", "--threads");
+    arg_parser.add_arg("-n");
+
+    for (int i = 0; i < 40; ++i)
+    {
+        arg_parser.add_arg("--option" + std::to_string(i));
+    }
+
+    ASSERT_NE(nullptr, arg_parser.find_arg("-t"));
+    ASSERT_EQ("-t", arg_parser.find_arg("--threads")->id());
+    ASSERT_EQ("--option39", arg_parser.find_arg("--option39")->id());
+    ASSERT_EQ(nullptr, arg_parser.find_arg("--option40"));
+    ASSERT_EQ(nullptr, arg_parser.find_arg(""));
+
+    const int &threads = arg_parser.get<int>("--threads");
+    ASSERT_EQ(4, threads);
+    ASSERT_EQ(&threads, &arg_parser.get<int>("-t"));
+    ASSERT_EQ("name", arg_parser.get<std::string>("-n"));
+    ASSERT_EQ(&threads, &arg_parser.get<int>("-t"));
+
+    auto copy = arg_parser;
+    ASSERT_EQ("name", copy.get<std::string>("-n"));
+    ASSERT_NE(&threads, &copy.get<int>("-t"));
+
+    ASSERT_THROW(arg_parser.get<long>("-t"), errors::TypeMismatchError);
+    ASSERT_THROW(arg_parser.get<int>("--unknown"), errors::CommandLineArgumentError);
+    ASSERT_THROW(arg_parser.get<int>("--option1"), errors::CommandLineArgumentError);
+}
+
+
+//
+// ArgumentParser(<line>): quoted tokens, no response file expansion
+//
+TEST(TestParser, FromLine)
+{
+    using namespace cppargparse;
+    parser::ArgumentParser arg_parser("-n 'John Doe' -m \"a\\\"b\" @file", "TestParser");
+
+    const auto name = arg_parser.add_arg("-n");
+    const auto message = arg_parser.add_arg("-m");
+
+    ASSERT_EQ("John Doe", arg_parser.get_option<std::string>(name));
+    ASSERT_EQ((std::vector<std::string> {"a\"b", "@file"}), arg_parser.get_option<std::vector<std::string>>(message));
+
+    ASSERT_THROW(parser::ArgumentParser("-n 'open", "TestParser"), errors::TokenizerError);
+}
+
+
+//
+// Strict mode: unknown options are reported with their positions
+//
+TEST(TestParser, UnknownOptions)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--theads 8 -t -5 -o -.5 -v - file -x -- --raw"), "TestParser");
+
+    arg_parser.add_arg("-t", "--threads");
+    arg_parser.add_arg("-o");
+    arg_parser.add_arg("-v");
+
+    for (int i = 0; i < 100; ++i)
+    {
+        arg_parser.add_arg("--option" + std::to_string(i));
+    }
+
+    const auto unknown = arg_parser.unknown_options();
+
+    ASSERT_EQ(size_t(2), unknown.size());
+    ASSERT_EQ("--theads", unknown[0].token);
+    ASSERT_EQ(size_t(0), unknown[0].position);
+    ASSERT_EQ("-x", unknown[1].token);
+    ASSERT_EQ(size_t(9), unknown[1].position);
+
+    try
+    {
+        arg_parser.check_unknown_options();
+        FAIL();
+    }
+
+    catch (const errors::UnknownOptionError &error)
+    {
+        ASSERT_EQ(std::string("Error: 2 unknown option(s): '--theads' at position 0, '-x' at position 9"), error.what());
+        ASSERT_EQ(size_t(2), error.unknown().size());
+    }
+
+    auto strict_parser = test::make_arg_parser(test::parse_cmdargs("-t 8"), "TestParser");
+    strict_parser.add_arg("-t");
+
+    ASSERT_NO_THROW(strict_parser.check_unknown_options());
+}
+
+
+//
+// "--name=value", attached short values and bundled short flags
+//
+TEST(TestParser, ShortForms)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--timeout=5 -t7 -vxf -ofile -vxn out -l1 -v"), "TestParser");
+
+    const auto timeout = arg_parser.add_arg("--timeout");
+    const auto threads = arg_parser.add_arg("-t");
+    const auto verbose = arg_parser.add_arg("-v");
+    const auto extract = arg_parser.add_arg("-x");
+    const auto force = arg_parser.add_arg("-f");
+    const auto output = arg_parser.add_arg("-o");
+    const auto name = arg_parser.add_arg("-n");
+    const auto list = arg_parser.add_arg("-l");
+    const auto missing = arg_parser.add_arg("-i");
+
+    ASSERT_EQ(5, arg_parser.get_option<int>(timeout));
+    ASSERT_EQ(7, arg_parser.get_option<int>(threads));
+    ASSERT_TRUE(arg_parser.get_flag(verbose));
+    ASSERT_TRUE(arg_parser.get_flag(extract));
+    ASSERT_TRUE(arg_parser.get_flag(force));
+    ASSERT_EQ("file", arg_parser.get_option<std::string>(output));
+    ASSERT_EQ("out", arg_parser.get_option<std::string>(name));
+    ASSERT_EQ((std::vector<int> {1}), arg_parser.get_option<std::vector<int>>(list));
+    ASSERT_EQ(7, arg_parser.get<int>("-t"));
+    ASSERT_EQ(cmd::Source::CommandLine, arg_parser.get_source(output));
+
+    // "-i" is found inside "-ofile", but "le" aren't all short IDs
+    ASSERT_FALSE(arg_parser.get_flag(missing));
+
+    ASSERT_TRUE(arg_parser.unknown_options().empty());
+
+    int timeout_value = 0;
+    std::string output_value;
+    std::tie(timeout_value, output_value) = arg_parser.get_options<int, std::string>(timeout, output);
+
+    ASSERT_EQ(5, timeout_value);
+    ASSERT_EQ("file", output_value);
+
+    // Vector values end at bundled short options
+    auto vector_parser = test::make_arg_parser(test::parse_cmdargs("-m a b -vx"), "TestParser");
+    const auto messages = vector_parser.add_arg("-m");
+    vector_parser.add_arg("-v");
+    vector_parser.add_arg("-x");
+
+    ASSERT_EQ((std::vector<std::string> {"a", "b"}), vector_parser.get_option<std::vector<std::string>>(messages));
+}
+
+
+//
+// Conversion errors of attached values are reported at the position of the token holding them
+//
+TEST(TestParser, ShortFormsErrors)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-v -tX"), "TestParser");
+
+    arg_parser.add_arg("-v");
+    const auto threads = arg_parser.add_arg("-t");
+
+    const auto value = arg_parser.try_get_option<int>(threads);
+
+    ASSERT_EQ(errors::Code::InvalidValue, value.error());
+    ASSERT_EQ(size_t(1), value.position());
+
+    try
+    {
+        arg_parser.get_option<int>(threads);
+        FAIL();
+    }
+
+    catch (const errors::CommandLineOptionError &error)
+    {
+        ASSERT_EQ(errors::Code::InvalidValue, error.code());
+        ASSERT_EQ(size_t(1), error.position());
+        ASSERT_EQ(std::string("Error: Couldn't convert 'X' to type <int>."), error.what());
+    }
+}
+
+
+//
+// allow_abbreviations(): unique prefixes of long IDs resolve, ambiguous ones raise
+//
+TEST(TestParser, Abbreviations)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--verb --time=5 --ver"), "TestParser");
+
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+    const auto timeout = arg_parser.add_arg("--timeout");
+
+    ASSERT_FALSE(arg_parser.get_flag(verbose));
+    ASSERT_EQ(size_t(3), arg_parser.unknown_options().size());
+
+    arg_parser.allow_abbreviations();
+
+    ASSERT_TRUE(arg_parser.get_flag(verbose));
+    ASSERT_EQ(5, arg_parser.get_option<int>(timeout));
+    ASSERT_EQ(cmd::Source::CommandLine, arg_parser.get_source(verbose));
+
+    const auto version = arg_parser.add_arg("--version");
+
+    try
+    {
+        arg_parser.get_flag(version);
+        FAIL();
+    }
+
+    catch (const errors::AmbiguousOptionError &error)
+    {
+        ASSERT_EQ(std::string("Error: Ambiguous option '--ver' could be: --verbose --version"), error.what());
+        ASSERT_EQ((std::vector<std::string> {"--verbose", "--version"}), error.candidates());
+    }
+
+    ASSERT_EQ(5, arg_parser.get_option<int>(timeout));
+    ASSERT_EQ(size_t(1), arg_parser.unknown_options().size());
+
+    arg_parser.allow_abbreviations(false);
+
+    ASSERT_FALSE(arg_parser.get_flag(verbose));
+}
@@ -0,0 +1,190 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+#include <cppargparse/reload.h>
+
+#include "test_common.h"
+
+
+// Replace a file in the current working directory the way editors do: write a temporary file, then rename it
+void replace_file(const std::string &path, const std::string &contents)
+{
+    const std::string temporary = path + ".tmp";
+
+    {
+        std::ofstream file(temporary, std::ios::binary);
+        file << contents;
+    }
+
+    std::rename(temporary.c_str(), path.c_str());
+}
+
+
+//
+// Reloadable::reload(<configuration file>)
+//
+TEST(TestReload, ReloadConfigFile)
+{
+    using namespace cppargparse;
+    replace_file("test_reload.conf", "rate = 10\nverbose = yes\n");
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(""), "TestReload");
+    const auto rate = arg_parser.add_arg("-r", "--rate");
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+    const auto missing = arg_parser.add_arg("--missing");
+
+    reload::Reloadable settings("test_reload.conf", arg_parser.args());
+
+    ASSERT_EQ(10, settings.get_option<int>(rate));
+    ASSERT_TRUE(settings.get_flag(verbose));
+    ASSERT_EQ(7, settings.get_option<int>(missing, 7));
+    ASSERT_THROW(settings.get_option<int>(missing), errors::CommandLineArgumentError);
+
+    replace_file("test_reload.conf", "rate = 20\n");
+    ASSERT_TRUE(settings.reload());
+
+    ASSERT_EQ(20, settings.get_option<int>(rate));
+    ASSERT_FALSE(settings.get_flag(verbose));
+    ASSERT_EQ(uint64_t(1), settings.read()->generation());
+
+    // A broken file keeps the last good state
+    replace_file("test_reload.conf", "rate = [\n");
+    ASSERT_FALSE(settings.reload());
+    ASSERT_FALSE(settings.error().empty());
+    ASSERT_EQ(20, settings.get_option<int>(rate));
+
+    std::remove("test_reload.conf");
+}
+
+
+//
+// Reloadable::reload(<response file>)
+//
+TEST(TestReload, ReloadResponseFile)
+{
+    using namespace cppargparse;
+    replace_file("test_reload.rsp", "--hosts a b -v");
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(""), "TestReload");
+    const auto hosts = arg_parser.add_arg("--hosts");
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+
+    reload::Reloadable settings("test_reload.rsp", arg_parser.args(), reload::Format::ResponseFile);
+
+    ASSERT_EQ((std::vector<std::string> {"a", "b"}), settings.get_option<std::vector<std::string>>(hosts));
+    ASSERT_TRUE(settings.get_flag(verbose));
+
+    replace_file("test_reload.rsp", "--hosts c");
+    ASSERT_TRUE(settings.reload());
+
+    ASSERT_EQ((std::vector<std::string> {"c"}), settings.get_option<std::vector<std::string>>(hosts));
+    ASSERT_FALSE(settings.get_flag(verbose));
+
+    // Broken response files keep the last good state too
+    replace_file("test_reload.rsp", "--hosts 'open");
+    ASSERT_FALSE(settings.reload());
+    ASSERT_NE(std::string::npos, settings.error().find("Missing closing quote"));
+
+    replace_file("test_reload.rsp", "--hosts @test_reload.rsp");
+    ASSERT_FALSE(settings.reload());
+    ASSERT_NE(std::string::npos, settings.error().find("references itself"));
+    ASSERT_EQ((std::vector<std::string> {"c"}), settings.get_option<std::vector<std::string>>(hosts));
+
+    std::remove("test_reload.rsp");
+    ASSERT_FALSE(settings.reload());
+}
+
+
+//
+// Reloadable::start(): the watcher thread picks up replaced files
+//
+TEST(TestReload, Watch)
+{
+    using namespace cppargparse;
+    replace_file("test_reload_watch.conf", "rate = 1\n");
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(""), "TestReload");
+    const auto rate = arg_parser.add_arg("--rate");
+
+    reload::Reloadable settings("test_reload_watch.conf", arg_parser.args(),
+            reload::Format::ConfigFile, std::chrono::milliseconds(10));
+    settings.start();
+
+    replace_file("test_reload_watch.conf", "rate = 2\n");
+
+    // The polling fallback only sees modification times in seconds
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (settings.get_option<int>(rate) != 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    settings.stop();
+    ASSERT_EQ(2, settings.get_option<int>(rate));
+
+    std::remove("test_reload_watch.conf");
+}
+
+
+//
+// Readers never see a half-updated state while reloads are published
+//
+TEST(TestReload, ConcurrentReaders)
+{
+    using namespace cppargparse;
+    replace_file("test_reload_concurrent.conf", "a = 0\nb = 0\n");
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(""), "TestReload");
+    const auto a = arg_parser.add_arg("-a");
+    const auto b = arg_parser.add_arg("-b");
+
+    reload::Reloadable settings("test_reload_concurrent.conf", arg_parser.args());
+
+    std::atomic<bool> running(true);
+    std::atomic<size_t> mismatches(0);
+    std::vector<std::thread> readers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]()
+        {
+            while (running.load())
+            {
+                const auto state = settings.read();
+
+                if (state->get_option<int>(a) != state->get_option<int>(b))
+                {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= 50; ++i)
+    {
+        const std::string value = std::to_string(i);
+        replace_file("test_reload_concurrent.conf", "a = " + value + "\nb = " + value + "\n");
+        ASSERT_TRUE(settings.reload());
+    }
+
+    running.store(false);
+
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_EQ(size_t(0), mismatches.load());
+    ASSERT_EQ(50, settings.get_option<int>(a));
+
+    std::remove("test_reload_concurrent.conf");
+}
@@ -0,0 +1,97 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#define private public
+#include <cppargparse/cppargparse.h>
+#undef private
+
+#include "test_common.h"
+
+
+// Write a response file to the current working directory
+void write_file(const std::string &path, const std::string &contents)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+}
+
+
+//
+// ArgumentParser(<@file>)
+//
+TEST(TestResponse, Expand)
+{
+    using namespace cppargparse;
+    write_file("test_response_expand.rsp", "-t 3\n--name 'My Name'\n");
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-v @test_response_expand.rsp -x"), "TestResponse");
+
+    const cmd::CommandLine_t expected {
+        "-v", "-t", "3", "--name", "My Name", "-x"
+    };
+
+    ASSERT_EQ(expected, arg_parser.m_cmd);
+
+    const auto name = arg_parser.add_arg("--name");
+    ASSERT_EQ("My Name", arg_parser.get_option<std::string>(name));
+
+    std::remove("test_response_expand.rsp");
+}
+
+
+//
+// ArgumentParser(<nested @file>)
+//
+TEST(TestResponse, Nested)
+{
+    using namespace cppargparse;
+    write_file("test_response_outer.rsp", "-a @test_response_inner.rsp -b");
+    write_file("test_response_inner.rsp", std::string("1\0" "2\0", 4));
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("@test_response_outer.rsp"), "TestResponse");
+
+    const cmd::CommandLine_t expected {
+        "-a", "1", "2", "-b"
+    };
+
+    ASSERT_EQ(expected, arg_parser.m_cmd);
+
+    std::remove("test_response_outer.rsp");
+    std::remove("test_response_inner.rsp");
+}
+
+
+//
+// ArgumentParser(<@file referencing itself>)
+//
+TEST(TestResponse, Cycle)
+{
+    using namespace cppargparse;
+    write_file("test_response_cycle_a.rsp", "-a @test_response_cycle_b.rsp");
+    write_file("test_response_cycle_b.rsp", "-b @test_response_cycle_a.rsp");
+
+    ASSERT_THROW(test::make_arg_parser(test::parse_cmdargs("@test_response_cycle_a.rsp"), "TestResponse"),
+                 errors::ResponseFileError);
+
+    std::remove("test_response_cycle_a.rsp");
+    std::remove("test_response_cycle_b.rsp");
+}
+
+
+//
+// ArgumentParser(<@file which doesn't exist>)
+//
+TEST(TestResponse, MissingFile)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-u @user @"), "TestResponse");
+
+    const cmd::CommandLine_t expected {
+        "-u", "@user", "@"
+    };
+
+    ASSERT_EQ(expected, arg_parser.m_cmd);
+}
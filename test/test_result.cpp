@@ -0,0 +1,140 @@
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+// A user-defined type with a throwing converter only
+struct Level
+{
+    int value;
+};
+
+
+namespace cppargparse {
+
+
+template <>
+struct argument<Level>
+{
+    static const Level parse(
+            const cmd::CommandLine_t &cmd,
+            const cmd::CommandLinePosition_t &position,
+            const cmd::CommandLineArguments_t &cmdargs)
+    {
+        return Level {argument<int>::parse(cmd, position, cmdargs)};
+    }
+};
+
+
+} // namespace cppargparse
+
+
+//
+// argument<T>::try_convert() follows the std::sto*() semantics
+//
+TEST(TestResult, TryConvert)
+{
+    using namespace cppargparse;
+
+    const auto convert_int = [](const std::string &s, int &value)
+    {
+        return argument<int>::try_convert(s.data(), s.data() + s.size(), value);
+    };
+
+    int value;
+    ASSERT_EQ(errors::Code::None, convert_int(" 42abc", value));
+    ASSERT_EQ(42, value);
+    ASSERT_EQ(errors::Code::InvalidValue, convert_int("abc", value));
+    ASSERT_EQ(errors::Code::InvalidValue, convert_int("", value));
+    ASSERT_EQ(errors::Code::OutOfRange, convert_int("2147483648", value));
+    ASSERT_EQ(errors::Code::None, convert_int("-2147483648", value));
+    ASSERT_EQ(std::numeric_limits<int>::min(), value);
+
+    // Not NUL-terminated
+    const char digits[] = {'1', '2', '3'};
+    ASSERT_EQ(errors::Code::None, argument<int>::try_convert(digits, digits + 2, value));
+    ASSERT_EQ(12, value);
+
+    unsigned int unsigned_value = 0;
+    const std::string big = "4294967296";
+    ASSERT_EQ(errors::Code::OutOfRange, argument<unsigned int>::try_convert(big.data(), big.data() + big.size(), unsigned_value));
+
+    double double_value = 0.0;
+    const std::string huge = "1e999";
+    ASSERT_EQ(errors::Code::OutOfRange, argument<double>::try_convert(huge.data(), huge.data() + huge.size(), double_value));
+
+    // Longer than the stack buffer
+    const std::string padded = std::string(100, ' ') + "7";
+    ASSERT_EQ(errors::Code::None, convert_int(padded, value));
+    ASSERT_EQ(7, value);
+}
+
+
+//
+// ArgumentParser::try_get_option()
+//
+TEST(TestResult, TryGetOption)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 -x abc --sizes 1 2 x -l 3 -e"), "TestResult");
+
+    const auto threads = arg_parser.add_arg("-t");
+    const auto invalid = arg_parser.add_arg("-x");
+    const auto sizes = arg_parser.add_arg("--sizes");
+    const auto level = arg_parser.add_arg("-l");
+    const auto missing = arg_parser.add_arg("-m");
+    const auto empty = arg_parser.add_arg("-e");
+
+    const auto threads_result = arg_parser.try_get_option<int>(threads);
+    ASSERT_TRUE(threads_result.ok());
+    ASSERT_EQ(4, threads_result.value());
+
+    const auto invalid_result = arg_parser.try_get_option<int>(invalid);
+    ASSERT_FALSE(invalid_result);
+    ASSERT_EQ(errors::Code::InvalidValue, invalid_result.error());
+    ASSERT_EQ(size_t(3), invalid_result.position());
+
+    const auto sizes_result = arg_parser.try_get_option<std::vector<int>>(sizes);
+    ASSERT_EQ(errors::Code::InvalidValue, sizes_result.error());
+    ASSERT_EQ(size_t(7), sizes_result.position());
+
+    const auto missing_result = arg_parser.try_get_option<int>(missing);
+    ASSERT_EQ(errors::Code::MissingArgument, missing_result.error());
+    ASSERT_EQ(result::npos, missing_result.position());
+
+    const auto empty_result = arg_parser.try_get_option<int>(empty);
+    ASSERT_EQ(errors::Code::MissingValue, empty_result.error());
+    ASSERT_EQ(size_t(10), empty_result.position());
+
+    // Types without try_convert() fall back to argument::parse()
+    ASSERT_EQ(3, arg_parser.try_get_option<Level>(level).value().value);
+    ASSERT_EQ(errors::Code::InvalidValue, arg_parser.try_get_option<Level>(invalid).error());
+}
+
+
+//
+// ArgumentParser::get_option_or()
+//
+TEST(TestResult, GetOptionOr)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 -x abc"), "TestResult");
+
+    const auto threads = arg_parser.add_arg("-t");
+    const auto invalid = arg_parser.add_arg("-x");
+    const auto missing = arg_parser.add_arg("-m");
+
+    ASSERT_EQ(4, arg_parser.get_option_or<int>(threads, 1));
+    ASSERT_EQ(1, arg_parser.get_option_or<int>(invalid, 1));
+    ASSERT_EQ(1, arg_parser.get_option_or<int>(missing, 1));
+    ASSERT_EQ(std::string("none"), arg_parser.get_option_or<std::string>(missing, "none"));
+
+    // The defaulting get_option() overload shares the non-throwing path
+    ASSERT_EQ(1, arg_parser.get_option<int>(missing, 1));
+}
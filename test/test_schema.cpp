@@ -0,0 +1,312 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// Schema(<cmdargs>)
+//
+TEST(TestSchema, FromCommandLineArguments)
+{
+    using namespace cppargparse;
+
+    const cmd::CommandLine_t cmd;
+    const cmd::CommandLineArguments_t cmdargs {
+        {"-t", "--threads", std::string(), cmd.cend()},
+        {std::string(), std::string(), "positional", cmd.cend()},
+        {"-v", cmd.cend()}
+    };
+
+    const schema::Schema schema(cmdargs);
+
+    ASSERT_EQ(size_t(2), schema.size());
+    ASSERT_EQ(size_t(0), schema.find(std::string("--threads")));
+    ASSERT_EQ(size_t(1), schema.find(std::string("-v")));
+    ASSERT_EQ(schema::npos, schema.find(std::string("--verbose")));
+}
+
+
+//
+// parse_cmdline(<NUL separated buffer>)
+//
+TEST(TestSchema, ParseCmdline)
+{
+    using namespace cppargparse;
+
+    schema::Schema schema;
+    const size_t xmx = schema.add("-Xmx");
+    const size_t port = schema.add("-p", "--port");
+    const size_t hosts = schema.add("--hosts");
+    const size_t debug = schema.add("-d", "--debug");
+
+    const char cmdline[] = "java\0-Xmx\0" "4096\0--hosts\0a\0b\0\0--port\0" "8080\0app.jar\0";
+
+    schema::Result result;
+    schema::parse_cmdline(schema, cmdline, sizeof(cmdline) - 1, result);
+
+    ASSERT_EQ(size_t(10), result.tokens().size());
+    ASSERT_EQ(cmdline, result.tokens().front().data());
+
+    ASSERT_EQ(4096, result.get_option<int>(xmx));
+    ASSERT_EQ((std::vector<std::string> {"a", "b", ""}), result.get_values<std::string>(hosts));
+    ASSERT_EQ(8080, result.get_option<int>(port));
+    ASSERT_EQ(size_t(2), result.value_count(port));
+    ASSERT_EQ("app.jar", result.value(port, 1).str());
+    ASSERT_FALSE(result.get_flag(debug));
+    ASSERT_THROW(result.get_option<int>(debug), errors::CommandLineArgumentError);
+}
+
+
+//
+// parse_batch()
+//
+TEST(TestSchema, ParseBatch)
+{
+    using namespace cppargparse;
+
+    schema::Schema schema;
+    const size_t id = schema.add("--id");
+
+    std::vector<std::string> cmdlines;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        cmdlines.emplace_back(std::string("worker\0--id\0", 12) + std::to_string(i));
+    }
+
+    std::vector<cmd::TokenView> buffers(cmdlines.cbegin(), cmdlines.cend());
+    std::vector<schema::Result> results;
+
+    schema::parse_batch(schema, buffers, results, 4);
+
+    ASSERT_EQ(size_t(1000), results.size());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(i, results[i].get_option<int>(id));
+    }
+
+    // No more threads than batches are started, so a huge thread count costs nothing for a few buffers
+    buffers.resize(3);
+    schema::parse_batch(schema, buffers, results, 100000);
+
+    ASSERT_EQ(size_t(3), results.size());
+    ASSERT_EQ(2, results[2].get_option<int>(id));
+}
+
+
+//
+// Builder: compiles an immutable schema, shared by several threads
+//
+TEST(TestSchema, Builder)
+{
+    using namespace cppargparse;
+
+    schema::Builder builder;
+    std::vector<size_t> options;
+
+    for (int i = 0; i < 150; ++i)
+    {
+        options.push_back(builder.add("--option" + std::to_string(i), "-o" + std::to_string(i)));
+    }
+
+    const std::shared_ptr<const schema::Schema> schema = builder.build();
+
+    ASSERT_EQ(size_t(150), schema->size());
+    ASSERT_EQ(size_t(0), builder.build()->size());
+    ASSERT_EQ(options[42], schema->find(std::string("--option42")));
+    ASSERT_EQ(options[149], schema->find(std::string("-o149")));
+    ASSERT_EQ(schema::npos, schema->find(std::string("--option150")));
+
+    std::vector<std::thread> threads;
+    std::atomic<int> failures(0);
+
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&schema, &options, &failures, t]()
+        {
+            schema::Result result;
+
+            for (int i = 0; i < 150; ++i)
+            {
+                const std::string id = "--option" + std::to_string(i);
+                const std::string value = std::to_string(i * t);
+                const char *argv[] = {"request", id.c_str(), value.c_str()};
+
+                schema::parse(*schema, 3, argv, result);
+
+                if (result.get_option<int>(options[i]) != i * t || result.get_flag(options[(i + 1) % 150]))
+                {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(0, failures.load());
+}
+
+
+//
+// Result::get_option(): conversion errors are reported by the converter
+//
+TEST(TestSchema, ConversionError)
+{
+    using namespace cppargparse;
+
+    schema::Schema schema;
+    const size_t port = schema.add("-p");
+
+    const char *argv[] = {"-p", "http"};
+
+    schema::Result result;
+    schema::parse(schema, 2, argv, result);
+
+    ASSERT_THROW(result.get_option<int>(port), errors::CommandLineOptionError);
+    ASSERT_EQ("http", result.get_option<std::string>(port));
+}
+
+
+//
+// parse_line(<shell-like text>)
+//
+TEST(TestSchema, ParseLine)
+{
+    using namespace cppargparse;
+
+    schema::Schema schema;
+    const size_t name = schema.add("-n", "--name");
+    const size_t count = schema.add("-c");
+
+    tokenizer::Tokens tokens;
+    schema::Result result;
+
+    const std::string line("get --name 'John Doe' -c 3");
+    schema::parse_line(schema, line, tokens, result);
+
+    ASSERT_EQ(size_t(5), result.tokens().size());
+    ASSERT_EQ("John Doe", result.get_option<std::string>(name));
+    ASSERT_EQ(3, result.get_option<int>(count));
+
+    const std::string next("get -n \"a\\\"b\"");
+    schema::parse_line(schema, next, tokens, result);
+
+    ASSERT_EQ("a\"b", result.get_option<std::string>(name));
+    ASSERT_FALSE(result.get_flag(count));
+    ASSERT_THROW(schema::parse_line(schema, std::string("-n 'open"), tokens, result), errors::TokenizerError);
+}
+
+
+//
+// Schema::split(): bundled short flags and attached values, options taking a value end the bundle
+//
+TEST(TestSchema, Split)
+{
+    using namespace cppargparse;
+
+    schema::Schema schema;
+    const size_t verbose = schema.add("-v");
+    const size_t extract = schema.add("-x");
+    const size_t file = schema.add("-f");
+    const size_t timeout = schema.add("-t", "--timeout");
+    const size_t output = schema.add("-o", std::string(), true);
+    const size_t name = schema.add("--name");
+
+    const char *argv[] = {"-vxf", "-t5", "--timeout=7", "-ofile", "--name=", "-5", "-Xmx4096", "--other=1", "-vq", "-vof"};
+
+    schema::Result result;
+    schema::parse(schema, 10, argv, result);
+
+    std::vector<std::string> tokens;
+
+    for (const auto &token : result.tokens())
+    {
+        tokens.emplace_back(token.str());
+    }
+
+    const std::vector<std::string> expected {
+        "-v", "x", "f", "-t", "5", "--timeout", "7", "-o", "file", "--name", "", "-5", "-Xmx4096", "--other=1",
+        "-v", "q", "-v", "o", "f"
+    };
+
+    ASSERT_EQ(expected, tokens);
+    ASSERT_EQ(argv[3] + 2, result.value(output).data());
+
+    ASSERT_TRUE(result.get_flag(extract));
+    ASSERT_EQ(size_t(0), result.value_count(file));
+    ASSERT_EQ(5, result.get_option<int>(timeout));
+    ASSERT_EQ("file", result.get_option<std::string>(output));
+    ASSERT_EQ((std::vector<std::string> {"", "-5", "-Xmx4096", "--other=1"}), result.get_values<std::string>(name));
+    ASSERT_EQ(size_t(0), result.value_count(verbose));
+}
+
+
+//
+// Abbreviations: unique prefixes resolve, ambiguous ones are reported with their candidates
+//
+TEST(TestSchema, Abbreviations)
+{
+    using namespace cppargparse;
+
+    schema::Builder builder;
+    const size_t verbose = builder.add("-v", "--verbose");
+    const size_t version = builder.add("--version");
+    const size_t timeout = builder.add("--timeout", "--timeout-ms");
+    builder.add("--threads");
+    builder.allow_abbreviations();
+
+    const auto schema = builder.build();
+
+    ASSERT_EQ(verbose, schema->find_abbreviation(std::string("--verb")));
+    ASSERT_EQ(version, schema->find_abbreviation(std::string("--vers")));
+    ASSERT_EQ(timeout, schema->find_abbreviation(std::string("--ti")));
+    ASSERT_EQ(timeout, schema->find_abbreviation(std::string("--timeout-")));
+    ASSERT_EQ(schema::npos, schema->find_abbreviation(std::string("--verbosity")));
+    ASSERT_EQ(schema::npos, schema->find_abbreviation(std::string("--x")));
+
+    try
+    {
+        schema->find_abbreviation(std::string("--ver"));
+        FAIL();
+    }
+
+    catch (const errors::AmbiguousOptionError &error)
+    {
+        ASSERT_EQ((std::vector<std::string> {"--verbose", "--version"}), error.candidates());
+        ASSERT_EQ(std::string("Error: Ambiguous option '--ver' could be: --verbose --version"), error.what());
+    }
+
+    ASSERT_THROW(schema->find_abbreviation(std::string("--t")), errors::AmbiguousOptionError);
+
+    const char *argv[] = {"--verb", "--time=30", "--vers"};
+
+    schema::Result result;
+    schema::parse(*schema, 3, argv, result);
+
+    ASSERT_TRUE(result.get_flag(verbose));
+    ASSERT_TRUE(result.get_flag(version));
+    ASSERT_EQ(30, result.get_option<int>(timeout));
+
+    const char *ambiguous[] = {"--ver"};
+    ASSERT_THROW(schema::parse(*schema, 1, ambiguous, result), errors::AmbiguousOptionError);
+
+    // Not allowed: abbreviations are values
+    schema::Schema strict;
+    const size_t strict_verbose = strict.add("--verbose");
+
+    schema::parse(strict, 1, argv, result);
+    ASSERT_FALSE(result.get_flag(strict_verbose));
+}
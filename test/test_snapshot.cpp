@@ -0,0 +1,162 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+#include <cppargparse/io.h>
+
+#include "test_common.h"
+
+
+//
+// freeze() + View
+//
+TEST(TestSnapshot, FreezeAndView)
+{
+    using namespace cppargparse;
+    ::setenv("CPPARGPARSE_TEST_SNAPSHOT_PORT", "8080", 1);
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4 --hosts a b -v"), "TestSnapshot");
+
+    const auto threads = arg_parser.add_arg("-t", "--threads");
+    const auto hosts = arg_parser.add_arg("--hosts");
+    const auto verbose = arg_parser.add_arg("-v", "--verbose");
+    const auto port = arg_parser.add_arg("-p", "--port");
+    const auto missing = arg_parser.add_arg("--missing");
+    arg_parser.add_env_fallback(port, "CPPARGPARSE_TEST_SNAPSHOT_PORT");
+
+    const std::vector<char> blob = snapshot::freeze(arg_parser);
+
+    // The blob is position independent
+    const std::vector<char> copy(blob);
+    const snapshot::View view(copy.data(), copy.size(), snapshot::schema_hash(arg_parser.args()));
+
+    ASSERT_EQ(size_t(5), view.size());
+    ASSERT_EQ(4, view.get_option<int>(threads));
+    ASSERT_EQ((std::vector<std::string> {"a", "b"}), view.get_option<std::vector<std::string>>(hosts));
+    ASSERT_TRUE(view.get_flag(verbose));
+    ASSERT_FALSE(view.get_flag(missing));
+    ASSERT_EQ(8080, view.get_option<int>(port));
+    ASSERT_EQ(cmd::Source::Environment, view.get_source(port));
+    ASSERT_EQ(cmd::Source::Default, view.get_source(missing));
+    ASSERT_EQ(42, view.get_option<int>(missing, 42));
+    ASSERT_THROW(view.get_option<int>(missing), errors::CommandLineArgumentError);
+}
+
+
+//
+// View rejects malformed blobs and schema mismatches
+//
+TEST(TestSnapshot, Validation)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4"), "TestSnapshot");
+    arg_parser.add_arg("-t", "--threads");
+
+    std::vector<char> blob = snapshot::freeze(arg_parser);
+    const uint64_t hash = snapshot::schema_hash(arg_parser.args());
+
+    ASSERT_THROW(snapshot::View(blob.data(), blob.size(), hash + 1), errors::SnapshotError);
+    ASSERT_THROW(snapshot::View(blob.data(), blob.size() - 1, hash), errors::SnapshotError);
+    ASSERT_THROW(snapshot::View(blob.data(), 4, hash), errors::SnapshotError);
+
+    blob[0] = 'X';
+    ASSERT_THROW(snapshot::View(blob.data(), blob.size(), hash), errors::SnapshotError);
+}
+
+
+//
+// View validates every record once on construction
+//
+TEST(TestSnapshot, MalformedRecords)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("-t 4"), "TestSnapshot");
+    arg_parser.add_arg("-t", "--threads");
+
+    const std::vector<char> blob = snapshot::freeze(arg_parser);
+    const uint64_t hash = snapshot::schema_hash(arg_parser.args());
+    const uint32_t out_of_bounds = static_cast<uint32_t>(blob.size());
+
+    // The value offset of the only value
+    std::vector<char> value = blob;
+    std::memcpy(value.data() + sizeof(snapshot::Header) + sizeof(snapshot::Option), &out_of_bounds, sizeof(uint32_t));
+    ASSERT_THROW(snapshot::View(value.data(), value.size(), hash), errors::SnapshotError);
+
+    // The ID offset of the only option
+    std::vector<char> id = blob;
+    std::memcpy(id.data() + sizeof(snapshot::Header) + offsetof(snapshot::Option, id), &out_of_bounds, sizeof(uint32_t));
+    ASSERT_THROW(snapshot::View(id.data(), id.size(), hash), errors::SnapshotError);
+
+    ASSERT_NO_THROW(snapshot::View(blob.data(), blob.size(), hash));
+}
+
+
+//
+// View finds every option among many and converts values like the parser
+//
+TEST(TestSnapshot, Lookup)
+{
+    using namespace cppargparse;
+
+    std::string cmdline;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        cmdline += "--option" + std::to_string(i) + " " + std::to_string(i * 3) + " ";
+    }
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(cmdline + "--name x"), "TestSnapshot");
+    std::vector<cmd::CommandLineArgument> options;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        options.emplace_back(arg_parser.add_arg("--option" + std::to_string(i)));
+    }
+
+    const auto name = arg_parser.add_arg("--name");
+
+    const std::vector<char> blob = snapshot::freeze(arg_parser);
+    const snapshot::View view(blob.data(), blob.size(), snapshot::schema_hash(arg_parser.args()));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(i * 3, view.get_option<int>(options[static_cast<size_t>(i)]));
+    }
+
+    ASSERT_EQ("x", view.get_option<std::string>(name));
+    ASSERT_THROW(view.get_option<int>(name), errors::CommandLineOptionError);
+    ASSERT_EQ(7, view.get_option<int>(name, 7));
+    ASSERT_EQ((std::vector<int> {3}), view.get_option<std::vector<int>>(options[1]));
+}
+
+
+#ifdef CPPARGPARSE_HAS_MMAP
+//
+// write_shared() + io::MappedFile(<fd>)
+//
+TEST(TestSnapshot, SharedMemory)
+{
+    using namespace cppargparse;
+
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--name worker"), "TestSnapshot");
+    const auto name = arg_parser.add_arg("--name");
+
+    const std::vector<char> blob = snapshot::freeze(arg_parser);
+    const int fd = snapshot::write_shared(blob);
+
+    const io::MappedFile mapping(fd);
+    ::close(fd);
+
+    ASSERT_TRUE(mapping.is_open());
+
+    const snapshot::View view(mapping.data(), mapping.size(), snapshot::schema_hash(arg_parser.args()));
+    ASSERT_EQ("worker", view.get_option<std::string>(name));
+}
+#endif
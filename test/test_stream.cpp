@@ -0,0 +1,122 @@
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+// Return the read end of a pipe which holds <data>
+int make_pipe(const std::string &data)
+{
+    int fds[2];
+
+    if (::pipe(fds) != 0 || ::write(fds[1], data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+    {
+        return -1;
+    }
+
+    ::close(fds[1]);
+    return fds[0];
+}
+
+
+//
+// TokenReader::next(<NUL delimited, tokens across chunk boundaries>)
+//
+TEST(TestStream, NulDelimited)
+{
+    using namespace cppargparse;
+
+    const std::string long_token(100, 'x');
+    const int fd = make_pipe(std::string("a.txt\0dir/b.txt\0", 16) + long_token + std::string("\0\0last", 6));
+
+    stream::TokenReader reader(fd, '\0', 4);
+    std::vector<std::string> tokens;
+
+    reader.for_each([&tokens](const cmd::TokenView &token)
+    {
+        tokens.emplace_back(token.str());
+    });
+
+    const std::vector<std::string> expected {
+        "a.txt", "dir/b.txt", long_token, "", "last"
+    };
+
+    ASSERT_EQ(expected, tokens);
+    ::close(fd);
+}
+
+
+//
+// TokenReader::begin()/end() (newline delimited)
+//
+TEST(TestStream, NewlineDelimitedRange)
+{
+    using namespace cppargparse;
+
+    const int fd = make_pipe("one\r\ntwo\n\nthree");
+
+    stream::TokenReader reader(fd, '\n', 5);
+    std::vector<std::string> tokens;
+
+    for (const cmd::TokenView &token : reader)
+    {
+        tokens.emplace_back(token.str());
+    }
+
+    ASSERT_EQ((std::vector<std::string> {"one", "two", "three"}), tokens);
+    ::close(fd);
+}
+
+
+//
+// for_each_value<T>()
+//
+TEST(TestStream, ForEachValue)
+{
+    using namespace cppargparse;
+
+    const int fd = make_pipe("1\n22\n333\nx\n");
+
+    stream::TokenReader reader(fd, '\n');
+    int sum = 0;
+
+    ASSERT_THROW(stream::for_each_value<int>(reader, [&sum](const int value) { sum += value; }),
+                 errors::CommandLineOptionError);
+    ASSERT_EQ(356, sum);
+    ::close(fd);
+}
+
+
+//
+// ArgumentParser::stream_option()
+//
+TEST(TestStream, StreamOption)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs("--files - --sizes 1 2 3"), "TestStream");
+
+    const auto files = arg_parser.add_arg("--files");
+    const auto sizes = arg_parser.add_arg("--sizes");
+
+    const int fd = make_pipe(std::string("a\0b\0c\0", 6));
+    std::vector<std::string> streamed;
+
+    ASSERT_EQ(size_t(3), arg_parser.stream_option<std::string>(files, [&streamed](const std::string &file)
+    {
+        streamed.emplace_back(file);
+    }, '\0', fd));
+
+    ASSERT_EQ((std::vector<std::string> {"a", "b", "c"}), streamed);
+    ::close(fd);
+
+    long total = 0;
+
+    ASSERT_EQ(size_t(3), arg_parser.stream_option<long>(sizes, [&total](const long size) { total += size; }));
+    ASSERT_EQ(6l, total);
+}
@@ -0,0 +1,129 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+#include <cppargparse/tokenizer.h>
+
+#include "test_common.h"
+
+
+// Collect all tokens of an input string
+std::vector<std::string> tokenize(const std::string &input)
+{
+    std::vector<std::string> tokens;
+
+    cppargparse::tokenizer::for_each_token(input.data(), input.data() + input.size(),
+                                           [&tokens](const cppargparse::cmd::TokenView &token)
+    {
+        tokens.emplace_back(token.str());
+    });
+
+    return tokens;
+}
+
+
+//
+// for_each_token(<whitespace and NUL separated>)
+//
+TEST(TestTokenizer, Separators)
+{
+    const char raw[] = "-t 3\t-f\n\n5  \0--seq\r\n1 2";
+    const std::string input(raw, sizeof(raw) - 1);
+
+    const std::vector<std::string> expected {
+        "-t", "3", "-f", "5", "--seq", "1", "2"
+    };
+
+    ASSERT_EQ(expected, tokenize(input));
+}
+
+
+//
+// for_each_token(<plain tokens are views into the input>)
+//
+TEST(TestTokenizer, ZeroCopy)
+{
+    using namespace cppargparse;
+
+    const std::string input("-o 'my file.txt' \"quoted\"");
+    std::vector<cmd::TokenView> views;
+
+    tokenizer::for_each_token(input.data(), input.data() + input.size(), [&views](const cmd::TokenView &token)
+    {
+        views.emplace_back(token);
+    });
+
+    ASSERT_EQ(size_t(3), views.size());
+    ASSERT_EQ(input.data(), views.at(0).data());
+    ASSERT_EQ(input.data() + 4, views.at(1).data());
+    ASSERT_EQ("my file.txt", views.at(1).str());
+    ASSERT_EQ("quoted", views.at(2).str());
+}
+
+
+//
+// for_each_token(<quoting and escapes>)
+//
+TEST(TestTokenizer, Quoting)
+{
+    const std::vector<std::string> expected {
+        "a b", "it's", "x\"y", "mixed quoted", "back\\slash", "", "lit\\n"
+    };
+
+    ASSERT_EQ(expected, tokenize("a\\ b it\\'s \"x\\\"y\" mixed' 'quoted 'back\\slash' \"\" 'lit\\n'"));
+}
+
+
+//
+// for_each_token(<unbalanced quotes>)
+//
+TEST(TestTokenizer, UnbalancedQuotes)
+{
+    using namespace cppargparse;
+
+    ASSERT_THROW(tokenize("-t 'open"), errors::TokenizerError);
+    ASSERT_THROW(tokenize("-t \"open"), errors::TokenizerError);
+}
+
+
+//
+// Tokens: views into the line, unescaped tokens in the holder, memory reused
+//
+TEST(TestTokenizer, Tokens)
+{
+    using namespace cppargparse;
+
+    const std::string first("-o 'my file.txt' a\\ b \"x\\\"y\" -v");
+    const std::string second("-o \"b\\\\c\" d\\ e");
+
+    tokenizer::Tokens tokens;
+    tokens.assign(first);
+
+    ASSERT_EQ(size_t(5), tokens.size());
+    ASSERT_EQ(first.data(), tokens[0].data());
+    ASSERT_EQ(first.data() + 4, tokens[1].data());
+    ASSERT_EQ("my file.txt", tokens[1].str());
+    ASSERT_EQ("a b", tokens[2].str());
+    ASSERT_EQ("x\"y", tokens[3].str());
+    ASSERT_EQ("-v", tokens[4].str());
+
+    const char *unescaped = tokens[2].data();
+    tokens.assign(second);
+
+    ASSERT_EQ(size_t(3), tokens.size());
+    ASSERT_EQ("b\\c", tokens[1].str());
+    ASSERT_EQ("d e", tokens[2].str());
+    ASSERT_EQ(unescaped, tokens[1].data());
+
+    std::vector<std::string> strings;
+
+    for (const auto &token : tokens)
+    {
+        strings.emplace_back(token.str());
+    }
+
+    ASSERT_EQ((std::vector<std::string> {"-o", "b\\c", "d e"}), strings);
+    ASSERT_EQ((cmd::CommandLine_t {"-o", "b\\c", "d e"}), tokenizer::split(second));
+}
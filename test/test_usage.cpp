@@ -0,0 +1,101 @@
+#include <cstdio>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <cppargparse/cppargparse.h>
+
+#include "test_common.h"
+
+
+//
+// usage::render(<no wrapping>)
+//
+TEST(TestUsage, Render)
+{
+    using namespace cppargparse;
+
+    const cmd::CommandLine_t cmd;
+    const cmd::CommandLineArguments_t cmdargs {
+        {"-h", "--help", "Display this information", cmd.cend()},
+        {"--threads", std::string(), "The number of threads", cmd.cend()},
+        {"-v", std::string(), std::string(), cmd.cend()}
+    };
+
+    ASSERT_EQ(
+        "Usage: app\n"
+        "\n"
+        "  -h|--help   Display this information\n"
+        "  --threads   The number of threads\n"
+        "  -v\n",
+        usage::render("app", cmdargs, 0));
+}
+
+
+//
+// usage::render(<width>)
+//
+TEST(TestUsage, Wrap)
+{
+    using namespace cppargparse;
+
+    const cmd::CommandLine_t cmd;
+    const cmd::CommandLineArguments_t cmdargs {
+        {"-t", std::string(), "one two three four five six seven eight nine", cmd.cend()},
+        {"-x", std::string(), "abcdefghijklmnopqrstuvwxyzabcdefghijklmnop", cmd.cend()}
+    };
+
+    // Description column 7, 23 characters left per line
+    ASSERT_EQ(
+        "Usage: app\n"
+        "\n"
+        "  -t   one two three four five\n"
+        "       six seven eight nine\n"
+        "  -x   abcdefghijklmnopqrstuvw\n"
+        "       xyzabcdefghijklmnop\n",
+        usage::render("app", cmdargs, 30));
+
+    // Too narrow to wrap
+    ASSERT_EQ(usage::render("app", cmdargs, 0), usage::render("app", cmdargs, 20));
+}
+
+
+//
+// ArgumentParser::usage() is cached until an argument is added
+//
+TEST(TestUsage, Cache)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(""), "TestUsage");
+
+    arg_parser.add_arg("-a", "--all", "Everything");
+    const std::string &usage = arg_parser.usage();
+
+    ASSERT_EQ(&usage, &arg_parser.usage());
+    ASSERT_EQ(std::string::npos, usage.find("--verbose"));
+
+    arg_parser.add_arg("-v", "--verbose", "More output");
+    ASSERT_NE(std::string::npos, arg_parser.usage().find("--verbose"));
+    ASSERT_EQ(usage::render("TestUsage", arg_parser.args(), 40), arg_parser.usage(40));
+}
+
+
+//
+// ArgumentParser::write_usage(<fd>)
+//
+TEST(TestUsage, WriteUsage)
+{
+    using namespace cppargparse;
+    auto arg_parser = test::make_arg_parser(test::parse_cmdargs(""), "TestUsage");
+    arg_parser.add_help();
+
+    std::FILE *file = std::tmpfile();
+    ASSERT_TRUE(arg_parser.write_usage(::fileno(file)));
+
+    std::rewind(file);
+    char buffer[256] = {};
+    const size_t size = std::fread(buffer, 1, sizeof(buffer) - 1, file);
+    std::fclose(file);
+
+    ASSERT_EQ(arg_parser.usage(), std::string(buffer, size));
+}